@@ -0,0 +1,631 @@
+/* -*- c++ -*- */
+/* 
+ * Copyright 2016 Andrej Rode.
+ * 
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ * 
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Monte-Carlo BER/SER simulation of a GFDM link built from the kernels of
+ * libgfdm-kernels:
+ *
+ *   QAM -> modulator_kernel_cc -> nco_cc -> add_cyclic_prefix_cc -> channel
+ *       -> CP removal, equalizer -> kernel::gfdm_receiver (SIC) -> slicer
+ *
+ * The channel adds white Gaussian noise, with --channel multipath after a
+ * Rayleigh block fading channel with an exponential power delay profile,
+ * drawn anew for every frame and equalized in the frequency domain with
+ * perfect channel knowledge. Frames run in batches on a work-stealing thread
+ * pool. Every batch draws from its own random stream, seeded from --seed,
+ * the SNR point and the batch number, so a batch gives the same frames on
+ * whichever thread runs it. An SNR point stops
+ * once it has collected --target-errors bit errors or run --max-frames
+ * frames. Results go to stdout as CSV or JSON, one record per
+ * (K, M, Es/N0), e.g.
+ *
+ *   gfdm_ber_sim -K 64 -M 15 --qam 16 --snr 0:2:20 --ic-iter 2 --channel multipath
+ */
+
+#include <gfdm/modulator_kernel_cc.h>
+#include <gfdm/add_cyclic_prefix_cc.h>
+#include <gfdm/nco_cc.h>
+#include <gfdm/gfdm_receiver.h>
+#include <gfdm/gfdm_utils.h>
+#include <gfdm/fft_plan.h>
+#include <gfdm/stage_timers.h>
+#include "work_stealing_pool.h"
+#include <volk/volk.h>
+#include <boost/program_options.hpp>
+#include <boost/algorithm/string.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/normal_distribution.hpp>
+#include <boost/random/seed_seq.hpp>
+#include <boost/atomic.hpp>
+#include <boost/bind.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/thread.hpp>
+#include <iostream>
+#include <vector>
+#include <string>
+#include <stdexcept>
+#include <algorithm>
+#include <cstring>
+#include <cmath>
+
+namespace po = boost::program_options;
+typedef std::complex<float> gfdm_complex;
+typedef boost::random::mt19937 rng_t;
+using gr::gfdm::work_stealing_pool;
+
+static std::vector<std::string>
+split_list(const std::string& s, const char* separators)
+{
+  std::vector<std::string> fields;
+  boost::split(fields, s, boost::is_any_of(separators));
+  for(size_t i = 0; i < fields.size(); i++){
+    boost::trim(fields[i]);
+  }
+  return fields;
+}
+
+static std::vector<int>
+parse_int_list(const std::string& s)
+{
+  const std::vector<std::string> fields = split_list(s, ",");
+  std::vector<int> values;
+  for(size_t i = 0; i < fields.size(); i++){
+    values.push_back(boost::lexical_cast<int>(fields[i]));
+  }
+  return values;
+}
+
+//! "start:step:stop" or a comma separated list.
+static std::vector<double>
+parse_snr_list(const std::string& s)
+{
+  std::vector<double> values;
+  if(s.find(':') == std::string::npos){
+    const std::vector<std::string> fields = split_list(s, ",");
+    for(size_t i = 0; i < fields.size(); i++){
+      values.push_back(boost::lexical_cast<double>(fields[i]));
+    }
+    return values;
+  }
+  const std::vector<std::string> fields = split_list(s, ":");
+  if(fields.size() != 3){
+    throw std::invalid_argument("--snr range MUST be start:step:stop");
+  }
+  const double start = boost::lexical_cast<double>(fields[0]);
+  const double step = boost::lexical_cast<double>(fields[1]);
+  const double stop = boost::lexical_cast<double>(fields[2]);
+  if(step <= 0.0){
+    throw std::invalid_argument("--snr step MUST be positive");
+  }
+  for(int i = 0; start + i * step <= stop + 1e-9; i++){
+    values.push_back(start + i * step);
+  }
+  return values;
+}
+
+static int
+popcount(unsigned int x)
+{
+  int n = 0;
+  for(; x; x &= x - 1){
+    n++;
+  }
+  return n;
+}
+
+//! Square QAM with unit average energy, Gray coded per axis.
+class qam_t
+{
+public:
+  qam_t(int order)
+    : d_bits(0)
+  {
+    while((1 << d_bits) < order){
+      d_bits++;
+    }
+    if(order < 4 || (1 << d_bits) != order || d_bits % 2){
+      throw std::invalid_argument("QAM order MUST be a square power of 2, e.g. 4, 16, 64 or 256");
+    }
+    d_levels = 1 << (d_bits / 2);
+    d_scale = std::sqrt(1.5f / (order - 1));
+    d_gray.resize(d_levels);
+    d_level.resize(d_levels);
+    for(int i = 0; i < d_levels; i++){
+      d_gray[i] = i ^ (i >> 1);
+      d_level[d_gray[i]] = i;
+    }
+    for(int v = 0; v < order; v++){
+      d_points.push_back(point(v));
+    }
+  }
+
+  int bits() const { return d_bits;};
+  const std::vector<gfdm_complex>& points() const { return d_points;};
+
+  gfdm_complex
+  point(int value) const
+  {
+    return gfdm_complex(amplitude(value >> (d_bits / 2)), amplitude(value & (d_levels - 1)));
+  }
+
+  //! Value of the point nearest to x.
+  int
+  decide(gfdm_complex x) const
+  {
+    return (gray(x.real()) << (d_bits / 2)) | gray(x.imag());
+  }
+
+private:
+  int d_bits;
+  int d_levels;
+  float d_scale;
+  std::vector<int> d_gray;
+  std::vector<int> d_level;
+  std::vector<gfdm_complex> d_points;
+
+  float amplitude(int gray) const { return d_scale * (2 * d_level[gray] - (d_levels - 1));};
+
+  int
+  gray(float x) const
+  {
+    const int level = int(std::floor(0.5f * (x / d_scale + d_levels)));
+    return d_gray[std::max(0, std::min(d_levels - 1, level))];
+  }
+};
+
+struct link_config_t {
+  int K;
+  int M;
+  int cp_len;
+  double alpha;
+  int ic_iter;
+  bool multipath;
+  int n_taps;
+  double decay_db;
+  bool mmse;
+};
+
+struct error_counts_t {
+  long bit_errors;
+  long symbol_errors;
+};
+
+/*!
+ * One transmitter, channel and receiver chain, used by one thread only.
+ * modulator_kernel_cc puts subcarrier k around bin k * M, gfdm_receiver
+ * expects it N / 2 + (M + 1) / 2 bins higher. The NCO shifts every frame by
+ * that many bins, then in[k * M + m] of the modulator comes out at
+ * out[k + m * K] of the receiver.
+ */
+class link_t
+{
+public:
+  link_t(const link_config_t& c, const qam_t& qam)
+    : d_c(c), d_qam(qam), d_N(c.K * c.M),
+      d_mod(c.M, c.K, 2, frequency_taps(c)),
+      d_nco(double(d_N / 2 + (c.M + 1) / 2) / d_N),
+      d_cp(0, c.cp_len, d_N, std::vector<gfdm_complex>()),
+      d_rx(c.K, c.M, c.alpha, d_N),
+      d_values(d_N), d_data(d_N), d_block(d_N), d_frame(d_N + c.cp_len), d_out(d_N),
+      d_h(c.n_taps), d_pdp(c.n_taps)
+  {
+    d_time = alloc(d_N);
+    d_freq = alloc(d_N);
+    d_h_time = alloc(d_N);
+    d_h_freq = alloc(d_N);
+    d_rx_in = alloc(d_N);
+    d_fft = new gr::gfdm::fft_plan(d_N, d_time, d_freq, true);
+    d_h_fft = new gr::gfdm::fft_plan(d_N, d_h_time, d_h_freq, true);
+    d_ifft = new gr::gfdm::fft_plan(d_N, d_freq, d_rx_in, false);
+    std::memset(d_h_time, 0, sizeof(gfdm_complex) * d_N);
+
+    double pdp_sum = 0.0;
+    for(int l = 0; l < c.n_taps; l++){
+      d_pdp[l] = std::pow(10.0, -0.1 * c.decay_db * l);
+      pdp_sum += d_pdp[l];
+    }
+    for(int l = 0; l < c.n_taps; l++){
+      d_pdp[l] = std::sqrt(0.5 * d_pdp[l] / pdp_sum);
+    }
+
+    // scale the transmitter for unit gain through modulator and receiver, the
+    // SIC decisions compare against the unscaled constellation.
+    d_tx_scale = 1.0f;
+    std::fill(d_data.begin(), d_data.end(), gfdm_complex(0.0f, 0.0f));
+    d_data[0] = 1.0f;
+    transmit();
+    std::memcpy(d_rx_in, &d_frame[c.cp_len], sizeof(gfdm_complex) * d_N);
+    d_rx.gfdm_work(&d_out[0], d_rx_in, d_N, d_N);
+    d_tx_scale = 1.0f / std::abs(d_out[0]);
+    // every symbol is spread with the same pulse energy, N symbols take N samples.
+    d_symbol_energy = 0.0;
+    for(int n = 0; n < d_N; n++){
+      d_symbol_energy += std::norm(d_frame[c.cp_len + n] * d_tx_scale);
+    }
+  }
+
+  ~link_t()
+  {
+    delete d_fft;
+    delete d_h_fft;
+    delete d_ifft;
+    volk_free(d_time);
+    volk_free(d_freq);
+    volk_free(d_h_time);
+    volk_free(d_h_freq);
+    volk_free(d_rx_in);
+  }
+
+  //! Es at the receiver input (before fading), Es/N0 refers to it.
+  double symbol_energy() const { return d_symbol_energy;};
+  //! Drop values the Gaussian source cached from the previous random stream.
+  void new_stream(){ d_normal.reset();};
+
+  void
+  run_frame(rng_t& rng, float noise_var, error_counts_t& counts)
+  {
+    const int shift = 32 - d_qam.bits();
+    for(int i = 0; i < d_N; i++){
+      d_values[i] = rng() >> shift;
+      d_data[i] = d_tx_scale * d_qam.points()[d_values[i]];
+    }
+    transmit();
+
+    const float sigma = std::sqrt(0.5f * noise_var);
+    if(d_c.multipath){
+      fading_channel(rng, sigma, noise_var);
+    }
+    else{
+      for(int n = 0; n < d_N; n++){
+        d_rx_in[n] = d_frame[d_c.cp_len + n] + gfdm_complex(sigma * d_normal(rng), sigma * d_normal(rng));
+      }
+    }
+
+    if(d_c.ic_iter > 0){
+      d_rx.gfdm_work_ic(&d_out[0], d_rx_in, d_c.ic_iter, d_qam.points());
+    }
+    else{
+      d_rx.gfdm_work(&d_out[0], d_rx_in, d_N, d_N);
+    }
+
+    for(int k = 0; k < d_c.K; k++){
+      for(int m = 0; m < d_c.M; m++){
+        const int sent = d_values[k * d_c.M + m];
+        const int received = d_qam.decide(d_out[k + m * d_c.K]);
+        if(sent != received){
+          counts.symbol_errors++;
+          counts.bit_errors += popcount(sent ^ received);
+        }
+      }
+    }
+  }
+
+private:
+  link_config_t d_c;
+  const qam_t& d_qam;
+  int d_N;
+  gr::gfdm::modulator_kernel_cc d_mod;
+  gr::gfdm::nco_cc d_nco;
+  gr::gfdm::add_cyclic_prefix_cc d_cp;
+  gr::gfdm::kernel::gfdm_receiver d_rx;
+  boost::random::normal_distribution<float> d_normal;
+  float d_tx_scale;
+  double d_symbol_energy;
+  std::vector<int> d_values;
+  std::vector<gfdm_complex> d_data;
+  std::vector<gfdm_complex> d_block;
+  std::vector<gfdm_complex> d_frame;
+  std::vector<gfdm_complex> d_out;
+  std::vector<gfdm_complex> d_h;
+  std::vector<double> d_pdp;
+  gfdm_complex* d_time;
+  gfdm_complex* d_freq;
+  gfdm_complex* d_h_time;
+  gfdm_complex* d_h_freq;
+  gfdm_complex* d_rx_in;
+  gr::gfdm::fft_plan* d_fft;
+  gr::gfdm::fft_plan* d_h_fft;
+  gr::gfdm::fft_plan* d_ifft;
+
+  static std::vector<gfdm_complex>
+  frequency_taps(const link_config_t& c)
+  {
+    std::vector<gfdm_complex> taps;
+    gr::gfdm::rrc_filter_sparse filter(c.K * c.M, c.alpha, 2, c.K, c.M);
+    filter.get_taps(taps);
+    taps.resize(2 * c.M, gfdm_complex(0.0f, 0.0f));
+    return taps;
+  }
+
+  static gfdm_complex*
+  alloc(int n)
+  {
+    return (gfdm_complex*) volk_malloc(sizeof(gfdm_complex) * n, volk_get_alignment());
+  }
+
+  //! d_data -> d_frame, cp_len + N samples.
+  void
+  transmit()
+  {
+    d_mod.generic_work(&d_block[0], &d_data[0]);
+    d_nco.reset();
+    d_nco.rotate(&d_frame[d_c.cp_len], &d_block[0], d_N);
+    d_cp.add_cyclic_prefix_in_place(&d_frame[0]);
+  }
+
+  //! Fade, add noise and equalize d_frame into d_rx_in. Taps never reach past the CP.
+  void
+  fading_channel(rng_t& rng, float sigma, float noise_var)
+  {
+    for(int l = 0; l < d_c.n_taps; l++){
+      d_h[l] = float(d_pdp[l]) * gfdm_complex(d_normal(rng), d_normal(rng));
+      d_h_time[l] = d_h[l];
+    }
+    const gfdm_complex* x = &d_frame[d_c.cp_len];
+    for(int n = 0; n < d_N; n++){
+      gfdm_complex y(sigma * d_normal(rng), sigma * d_normal(rng));
+      for(int l = 0; l < d_c.n_taps; l++){
+        y += d_h[l] * x[n - l];
+      }
+      d_time[n] = y;
+    }
+    d_fft->execute();
+    d_h_fft->execute();
+
+    // ZF or MMSE per bin, normalized for the unnormalized FFT pair.
+    const float gamma = d_c.mmse ? float(noise_var / d_symbol_energy) : 0.0f;
+    const float norm = 1.0f / d_N;
+    for(int f = 0; f < d_N; f++){
+      const gfdm_complex h = d_h_freq[f];
+      d_freq[f] *= norm * std::conj(h) / (std::norm(h) + gamma);
+    }
+    d_ifft->execute();
+  }
+};
+
+struct snr_point_t {
+  uint32_t index;
+  double snr_db;
+  float noise_var;
+  boost::atomic<long> issued;
+  boost::atomic<long> frames;
+  boost::atomic<long> bit_errors;
+  boost::atomic<long> symbol_errors;
+
+  snr_point_t(uint32_t index_, double snr_db_, float noise_var_)
+    : index(index_), snr_db(snr_db_), noise_var(noise_var_), issued(0), frames(0), bit_errors(0), symbol_errors(0) {}
+};
+
+/*!
+ * All SNR points of one link configuration. Every point starts with one
+ * batch per worker, a finished batch queues the next one of its point on
+ * the same worker until the point has enough errors or frames. Points that
+ * stop early leave their workers free to steal from the others.
+ */
+class simulation_t
+{
+public:
+  simulation_t(work_stealing_pool& pool, uint32_t seed,
+               const std::vector<boost::shared_ptr<link_t> >& links,
+               long target_errors, long max_frames, long batch)
+    : d_pool(pool), d_seed(seed), d_links(links),
+      d_target_errors(target_errors), d_max_frames(max_frames), d_batch(batch) {}
+
+  void
+  run(std::vector<boost::shared_ptr<snr_point_t> >& points)
+  {
+    for(size_t i = 0; i < points.size(); i++){
+      for(int w = 0; w < d_pool.size(); w++){
+        submit_batch(points[i].get(), w);
+      }
+    }
+    d_pool.wait();
+  }
+
+private:
+  work_stealing_pool& d_pool;
+  uint32_t d_seed;
+  const std::vector<boost::shared_ptr<link_t> >& d_links;
+  long d_target_errors;
+  long d_max_frames;
+  long d_batch;
+
+  void
+  submit_batch(snr_point_t* p, int worker)
+  {
+    if(p->bit_errors.load() >= d_target_errors){
+      return;
+    }
+    const long first = p->issued.fetch_add(d_batch);
+    if(first >= d_max_frames){
+      return;
+    }
+    const long n = std::min(d_batch, d_max_frames - first);
+    d_pool.submit(boost::bind(&simulation_t::run_batch, this, p, first / d_batch, n, _1), worker);
+  }
+
+  void
+  run_batch(snr_point_t* p, long batch_index, long n, int worker)
+  {
+    const uint32_t key[] = {d_seed, p->index, uint32_t(batch_index)};
+    boost::random::seed_seq seq(key, key + 3);
+    rng_t rng(seq);
+    d_links[worker]->new_stream();
+    error_counts_t counts = {0, 0};
+    for(long i = 0; i < n; i++){
+      d_links[worker]->run_frame(rng, p->noise_var, counts);
+    }
+    p->frames += n;
+    p->bit_errors += counts.bit_errors;
+    p->symbol_errors += counts.symbol_errors;
+    submit_batch(p, worker);
+  }
+};
+
+int
+main(int argc, char **argv)
+{
+  std::string K_list;
+  std::string M_list;
+  std::string snr_list;
+  std::string channel;
+  std::string equalizer;
+  std::string format;
+  int cp_len;
+  double alpha;
+  int qam_order;
+  int ic_iter;
+  int n_taps;
+  double decay_db;
+  long target_errors;
+  long max_frames;
+  long batch;
+  int nthreads;
+  unsigned int seed;
+
+  po::options_description desc("gfdm_ber_sim [options]");
+  desc.add_options()
+    ("help,h", "show this help")
+    ("subcarriers,K", po::value<std::string>(&K_list)->default_value("64"), "comma separated subcarrier counts")
+    ("timeslots,M", po::value<std::string>(&M_list)->default_value("15"), "comma separated timeslot counts")
+    ("cp-len", po::value<int>(&cp_len)->default_value(-1), "cyclic prefix length, K if negative")
+    ("alpha", po::value<double>(&alpha)->default_value(0.35), "roll-off of the RRC filter")
+    ("qam", po::value<int>(&qam_order)->default_value(4), "QAM order, 4, 16, 64, 256, ...")
+    ("ic-iter", po::value<int>(&ic_iter)->default_value(0), "SIC iterations in the receiver")
+    ("snr", po::value<std::string>(&snr_list)->default_value("0:2:20"), "Es/N0 in dB, start:step:stop or comma separated")
+    ("channel", po::value<std::string>(&channel)->default_value("awgn"), "awgn or multipath")
+    ("taps", po::value<int>(&n_taps)->default_value(8), "multipath taps, at most cp-len + 1")
+    ("decay", po::value<double>(&decay_db)->default_value(3.0), "multipath power decay per tap in dB")
+    ("equalizer", po::value<std::string>(&equalizer)->default_value("mmse"), "multipath equalizer, zf or mmse")
+    ("target-errors", po::value<long>(&target_errors)->default_value(1000), "bit errors after which an SNR point stops")
+    ("max-frames", po::value<long>(&max_frames)->default_value(100000), "frames after which an SNR point stops")
+    ("batch", po::value<long>(&batch)->default_value(16), "frames per task")
+    ("threads", po::value<int>(&nthreads)->default_value(boost::thread::hardware_concurrency()), "worker threads")
+    ("seed", po::value<unsigned int>(&seed)->default_value(1), "seed of the per-batch random streams")
+    ("format", po::value<std::string>(&format)->default_value("csv"), "csv or json");
+
+  try{
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+    if(vm.count("help")){
+      std::cout << desc << std::endl;
+      return 0;
+    }
+
+    const std::vector<int> Ks = parse_int_list(K_list);
+    const std::vector<int> Ms = parse_int_list(M_list);
+    const std::vector<double> snrs = parse_snr_list(snr_list);
+    const qam_t qam(qam_order);
+    if(channel != "awgn" && channel != "multipath"){
+      throw std::invalid_argument("--channel MUST be awgn or multipath");
+    }
+    if(equalizer != "zf" && equalizer != "mmse"){
+      throw std::invalid_argument("--equalizer MUST be zf or mmse");
+    }
+    if(format != "csv" && format != "json"){
+      throw std::invalid_argument("--format MUST be csv or json");
+    }
+    if(target_errors < 1 || max_frames < 1 || batch < 1 || nthreads < 1 || ic_iter < 0){
+      throw std::invalid_argument("--target-errors, --max-frames, --batch and --threads MUST be positive");
+    }
+    const bool multipath = channel == "multipath";
+    if(!multipath){
+      n_taps = 1;
+    }
+
+    work_stealing_pool pool(nthreads);
+
+    std::ostream& os = std::cout;
+    os.precision(6);
+    if(format == "csv"){
+      os << "K,M,cp_len,alpha,qam,ic_iter,channel,esn0_db,ebn0_db,frames,bits,bit_errors,ber,symbols,symbol_errors,ser\n";
+    }
+    else{
+      os << "{\n  \"simulation\": \"gfdm_ber\",\n  \"seed\": " << seed << ",\n  \"target_errors\": " << target_errors
+         << ",\n  \"max_frames\": " << max_frames << ",\n  \"results\": [";
+    }
+    bool first = true;
+
+    for(size_t ik = 0; ik < Ks.size(); ik++){
+      for(size_t im = 0; im < Ms.size(); im++){
+        link_config_t c = {Ks[ik], Ms[im], cp_len < 0 ? Ks[ik] : cp_len, alpha, ic_iter,
+                           multipath, n_taps, decay_db, equalizer == "mmse"};
+        if(c.n_taps < 1 || c.n_taps > c.cp_len + 1){
+          throw std::invalid_argument("--taps MUST be between 1 and cp-len + 1");
+        }
+        std::vector<boost::shared_ptr<link_t> > links;
+        for(int w = 0; w < nthreads; w++){
+          links.push_back(boost::shared_ptr<link_t>(new link_t(c, qam)));
+        }
+        std::vector<boost::shared_ptr<snr_point_t> > points;
+        for(size_t i = 0; i < snrs.size(); i++){
+          const float noise_var = links[0]->symbol_energy() * std::pow(10.0, -0.1 * snrs[i]);
+          points.push_back(boost::shared_ptr<snr_point_t>(new snr_point_t(i, snrs[i], noise_var)));
+        }
+
+        const uint64_t start = gr::gfdm::stage_timers::monotonic_ns();
+        simulation_t sim(pool, seed, links, target_errors, max_frames, batch);
+        sim.run(points);
+        const double seconds = 1e-9 * double(gr::gfdm::stage_timers::monotonic_ns() - start);
+
+        const long N = long(c.K) * c.M;
+        long total_frames = 0;
+        for(size_t i = 0; i < points.size(); i++){
+          const snr_point_t& p = *points[i];
+          const long symbols = p.frames.load() * N;
+          const long bits = symbols * qam.bits();
+          const double ber = double(p.bit_errors.load()) / bits;
+          const double ser = double(p.symbol_errors.load()) / symbols;
+          const double ebn0_db = p.snr_db - 10.0 * std::log10(double(qam.bits()));
+          total_frames += p.frames.load();
+          if(format == "csv"){
+            os << c.K << "," << c.M << "," << c.cp_len << "," << c.alpha << "," << qam_order << "," << c.ic_iter
+               << "," << channel << "," << p.snr_db << "," << ebn0_db << "," << p.frames.load() << "," << bits
+               << "," << p.bit_errors.load() << "," << ber << "," << symbols << "," << p.symbol_errors.load()
+               << "," << ser << "\n";
+          }
+          else{
+            os << (first ? "\n" : ",\n");
+            first = false;
+            os << "    {\"K\": " << c.K << ", \"M\": " << c.M << ", \"cp_len\": " << c.cp_len << ", \"alpha\": " << c.alpha
+               << ", \"qam\": " << qam_order << ", \"ic_iter\": " << c.ic_iter << ", \"channel\": \"" << channel
+               << "\", \"esn0_db\": " << p.snr_db << ", \"ebn0_db\": " << ebn0_db << ", \"frames\": " << p.frames.load()
+               << ", \"bits\": " << bits << ", \"bit_errors\": " << p.bit_errors.load() << ", \"ber\": " << ber
+               << ", \"symbols\": " << symbols << ", \"symbol_errors\": " << p.symbol_errors.load()
+               << ", \"ser\": " << ser << "}";
+          }
+        }
+        os.flush();
+        std::cerr << "K=" << c.K << " M=" << c.M << ": " << total_frames << " frames in " << seconds << " s ("
+                  << total_frames / seconds << " frames/s)" << std::endl;
+      }
+    }
+    if(format == "json"){
+      os << "\n  ]\n}\n";
+    }
+  }
+  catch(std::exception& e){
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
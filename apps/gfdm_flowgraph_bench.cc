@@ -0,0 +1,306 @@
+/* -*- c++ -*- */
+/* 
+ * Copyright 2016 Andrej Rode.
+ * 
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ * 
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+/*
+ * End-to-end throughput benchmark of a GFDM link:
+ *
+ *   random symbols -> framer -> modulator -> CP -> preamble insert
+ *     -> sync -> remove_prefix -> advanced receiver -> null sink
+ *
+ * or, with --fused, random symbols -> frame_transmitter -> sync -> frame_receiver -> null sink.
+ *
+ * For every (max_noutput_items, affinity) pair the flowgraph runs for a fixed
+ * time with the thread-per-block scheduler. Sustained rates and each block's
+ * share of the total work time (from the GNU Radio performance counters) are
+ * printed as JSON.
+ */
+
+#include <gnuradio/top_block.h>
+#include <gnuradio/prefs.h>
+#include <gnuradio/high_res_timer.h>
+#include <gnuradio/blocks/vector_source_c.h>
+#include <gnuradio/blocks/vector_insert_c.h>
+#include <gnuradio/blocks/null_sink.h>
+#include <gnuradio/digital/constellation.h>
+#include <gfdm/framer_cc.h>
+#include <gfdm/simple_modulator_cc.h>
+#include <gfdm/cyclic_prefixer_cc.h>
+#include <gfdm/sync_cc.h>
+#include <gfdm/remove_prefix_cc.h>
+#include <gfdm/advanced_receiver_cc.h>
+#include <gfdm/frame_transmitter_cc.h>
+#include <gfdm/frame_receiver_cc.h>
+#include <gfdm/preamble_generator.h>
+#include <gfdm/gfdm_utils.h>
+#include <gfdm/fft_plan.h>
+#include <boost/program_options.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/algorithm/string.hpp>
+#include <boost/lexical_cast.hpp>
+#include <iostream>
+#include <algorithm>
+#include <cstdlib>
+#include <cmath>
+#include <stdexcept>
+
+namespace po = boost::program_options;
+
+struct link_config_t {
+  int K;
+  int M;
+  int L;
+  int cp_len;
+  int ramp_len;
+  int sync_fft_len;
+  int ic_iter;
+  double alpha;
+  int n_frames;
+  bool fused;
+};
+
+struct link_t {
+  gr::top_block_sptr tb;
+  std::vector<gr::block_sptr> blocks;
+  std::vector<std::string> names;
+  gr::block_sptr channel;  // samples on air are counted at the sync input
+  gr::block_sptr sink;
+};
+
+static std::vector<int>
+parse_int_list(const std::string& s)
+{
+  std::vector<std::string> fields;
+  boost::split(fields, s, boost::is_any_of(","));
+  std::vector<int> values;
+  for(size_t i = 0; i < fields.size(); i++){
+    values.push_back(boost::lexical_cast<int>(boost::trim_copy(fields[i])));
+  }
+  return values;
+}
+
+static std::vector<gr_complex>
+raised_cosine_ramps(int ramp_len)
+{
+  // front and back ramp as in pygfdm.cyclic_prefix.get_raised_cosine_ramp
+  std::vector<gr_complex> taps(2 * ramp_len);
+  for(int i = 0; i < ramp_len; i++){
+    const float r = float(i) / ramp_len;
+    taps[i] = gr_complex(0.5f * (1.0f + std::cos(float(M_PI) * (1.0f - r))), 0.0f);
+    taps[ramp_len + i] = gr_complex(0.5f * (1.0f + std::cos(float(M_PI) * r)), 0.0f);
+  }
+  return taps;
+}
+
+static void
+add_block(link_t& link, const std::string& name, gr::block_sptr blk)
+{
+  link.blocks.push_back(blk);
+  link.names.push_back(name);
+}
+
+static link_t
+make_link(const link_config_t& c)
+{
+  link_t link;
+  link.tb = gr::make_top_block("gfdm_flowgraph_bench");
+
+  const int block_len = c.K * c.M;
+  const float a = 1.0f / std::sqrt(2.0f);
+  std::vector<gr_complex> symbols(c.n_frames * block_len);
+  for(size_t i = 0; i < symbols.size(); i++){
+    symbols[i] = gr_complex((std::rand() % 2) ? a : -a, (std::rand() % 2) ? a : -a);
+  }
+
+  std::vector<gr_complex> frequency_taps;
+  gr::gfdm::rrc_filter_sparse(block_len, c.alpha, c.L, c.K, c.M).get_taps(frequency_taps);
+  std::vector<gr_complex> window_taps = raised_cosine_ramps(c.ramp_len);
+  gr::gfdm::preamble_generator_sptr pregen = gr::gfdm::preamble_generator::make(c.K, c.alpha, c.sync_fft_len);
+  gr::digital::constellation_sptr constellation = gr::digital::constellation_qpsk::make();
+
+  gr::blocks::vector_source_c::sptr src = gr::blocks::vector_source_c::make(symbols, true);
+  gr::gfdm::sync_cc::sptr sync = gr::gfdm::sync_cc::make(c.sync_fft_len, c.cp_len, block_len, pregen);
+  gr::blocks::null_sink::sptr sink = gr::blocks::null_sink::make(sizeof(gr_complex));
+  add_block(link, "vector_source_c", src);
+
+  if(c.fused){
+    gr::gfdm::frame_transmitter_cc::sptr tx = gr::gfdm::frame_transmitter_cc::make(
+            c.M, c.K, c.L, frequency_taps, c.cp_len, c.ramp_len, window_taps, pregen);
+    gr::gfdm::frame_receiver_cc::sptr rx = gr::gfdm::frame_receiver_cc::make(
+            c.K, c.M, c.alpha, block_len, c.cp_len, c.sync_fft_len, c.ic_iter, constellation);
+    add_block(link, "frame_transmitter_cc", tx);
+    add_block(link, "sync_cc", sync);
+    add_block(link, "frame_receiver_cc", rx);
+  }
+  else{
+    // the preamble is inserted with its own cyclic prefix in front of every CP'ed data block.
+    std::vector<gr_complex> preamble = pregen->get_preamble();
+    std::vector<gr_complex> cp_preamble(preamble.end() - c.cp_len, preamble.end());
+    cp_preamble.insert(cp_preamble.end(), preamble.begin(), preamble.end());
+
+    add_block(link, "framer_cc", gr::gfdm::framer_cc::make(c.K, c.M, false, std::vector<gr_complex>(),
+                                                           gr::gfdm::preamble_generator_sptr()));
+    add_block(link, "simple_modulator_cc", gr::gfdm::simple_modulator_cc::make(c.M, c.K, c.L, frequency_taps));
+    add_block(link, "cyclic_prefixer_cc", gr::gfdm::cyclic_prefixer_cc::make(c.cp_len, c.ramp_len, block_len, window_taps));
+    add_block(link, "vector_insert_c", gr::blocks::vector_insert_c::make(cp_preamble,
+                                                                          cp_preamble.size() + block_len + c.cp_len, 0));
+    add_block(link, "sync_cc", sync);
+    add_block(link, "remove_prefix_cc", gr::gfdm::remove_prefix_cc::make(c.sync_fft_len, block_len, c.cp_len,
+                                                                         "gfdm_block", "gfdm_frame"));
+    add_block(link, "advanced_receiver_cc", gr::gfdm::advanced_receiver_cc::make(c.K, c.M, c.alpha, block_len,
+                                                                                 c.ic_iter, constellation));
+  }
+  add_block(link, "null_sink", sink);
+
+  for(size_t i = 0; i + 1 < link.blocks.size(); i++){
+    link.tb->connect(link.blocks[i], 0, link.blocks[i + 1], 0);
+  }
+  link.channel = sync;
+  link.sink = sink;
+  return link;
+}
+
+static void
+set_affinity(link_t& link, const std::string& mode)
+{
+  if(mode == "none"){
+    return;
+  }
+  if(mode != "spread"){
+    throw std::invalid_argument("affinity MUST be one of none,spread!");
+  }
+  // one core per block, round robin if there are more blocks than cores.
+  const int n_cores = std::max(1u, boost::thread::hardware_concurrency());
+  for(size_t i = 0; i < link.blocks.size(); i++){
+    link.blocks[i]->set_processor_affinity(std::vector<int>(1, i % n_cores));
+  }
+}
+
+static void
+run_case(const link_config_t& c, int max_noutput_items, const std::string& affinity,
+         double duration, bool first)
+{
+  link_t link = make_link(c);
+  set_affinity(link, affinity);
+  // measure steady state, not the FFTW_ESTIMATE plans blocks start on.
+  gr::gfdm::fft_plan::wait_for_upgrades();
+
+  const gr::high_res_timer_type start = gr::high_res_timer_now();
+  if(max_noutput_items > 0){
+    link.tb->start(max_noutput_items);
+  }
+  else{
+    link.tb->start();
+  }
+  boost::this_thread::sleep(boost::posix_time::milliseconds(long(1000 * duration)));
+  link.tb->stop();
+  link.tb->wait();
+  const double elapsed = double(gr::high_res_timer_now() - start) / gr::high_res_timer_tps();
+
+  std::vector<float> work_time(link.blocks.size());
+  float total_work_time = 0.0f;
+  for(size_t i = 0; i < link.blocks.size(); i++){
+    work_time[i] = link.blocks[i]->pc_work_time_total();
+    total_work_time += work_time[i];
+  }
+
+  const double samples = double(link.channel->nitems_read(0));
+  const double symbols = double(link.sink->nitems_read(0));
+  std::cout << (first ? "\n" : ",\n");
+  std::cout << "    {\"max_noutput_items\": " << max_noutput_items << ", \"affinity\": \"" << affinity << "\""
+            << ", \"elapsed_s\": " << elapsed
+            << ", \"samples\": " << samples << ", \"samples_per_s\": " << samples / elapsed
+            << ", \"rx_symbols_per_s\": " << symbols / elapsed << ",\n     \"blocks\": [";
+  for(size_t i = 0; i < link.blocks.size(); i++){
+    std::cout << (i ? ", " : "") << "{\"name\": \"" << link.names[i] << "\", \"work_share\": "
+              << (total_work_time > 0.0f ? work_time[i] / total_work_time : 0.0f) << "}";
+  }
+  std::cout << "]}";
+  std::cout.flush();
+}
+
+int
+main(int argc, char **argv)
+{
+  link_config_t c;
+  double duration;
+  std::string max_noutput_list;
+  std::string affinity_list;
+
+  po::options_description desc("gfdm_flowgraph_bench [options]");
+  desc.add_options()
+    ("help,h", "show this help")
+    ("subcarriers,K", po::value<int>(&c.K)->default_value(64), "number of subcarriers")
+    ("timeslots,M", po::value<int>(&c.M)->default_value(15), "number of timeslots")
+    ("cp-len", po::value<int>(&c.cp_len)->default_value(16), "cyclic prefix length")
+    ("ramp-len", po::value<int>(&c.ramp_len)->default_value(8), "block pinching ramp length")
+    ("sync-fft-len", po::value<int>(&c.sync_fft_len)->default_value(0), "preamble length, 0 means 2*K")
+    ("ic-iter", po::value<int>(&c.ic_iter)->default_value(2), "receiver interference cancellation iterations")
+    ("alpha", po::value<double>(&c.alpha)->default_value(0.35), "RRC roll-off")
+    ("frames", po::value<int>(&c.n_frames)->default_value(64), "random frames repeated by the source")
+    ("fused", po::bool_switch(&c.fused), "use frame_transmitter_cc and frame_receiver_cc")
+    ("duration", po::value<double>(&duration)->default_value(5.0), "seconds per run")
+    ("max-noutput", po::value<std::string>(&max_noutput_list)->default_value("0"),
+     "comma separated max_noutput_items values to sweep, 0 means scheduler default")
+    ("affinity", po::value<std::string>(&affinity_list)->default_value("none"),
+     "comma separated affinity modes to sweep: none,spread");
+
+  try{
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+    if(vm.count("help")){
+      std::cout << desc << std::endl;
+      return 0;
+    }
+    // the sparse RRC filter only supports an overlap of 2.
+    c.L = 2;
+    if(c.sync_fft_len == 0){
+      c.sync_fft_len = 2 * c.K;
+    }
+
+    // work time shares are only available with performance counters.
+    gr::prefs::singleton()->set_bool("PerfCounters", "on", true);
+
+    std::vector<int> max_noutputs = parse_int_list(max_noutput_list);
+    std::vector<std::string> affinities;
+    boost::split(affinities, affinity_list, boost::is_any_of(","));
+
+    std::srand(42);
+    std::cout << "{\n  \"config\": {\"K\": " << c.K << ", \"M\": " << c.M << ", \"L\": " << c.L
+              << ", \"cp_len\": " << c.cp_len << ", \"ramp_len\": " << c.ramp_len
+              << ", \"sync_fft_len\": " << c.sync_fft_len << ", \"ic_iter\": " << c.ic_iter
+              << ", \"fused\": " << (c.fused ? "true" : "false") << ", \"duration_s\": " << duration << "},\n"
+              << "  \"runs\": [";
+    bool first = true;
+    for(size_t i = 0; i < max_noutputs.size(); i++){
+      for(size_t j = 0; j < affinities.size(); j++){
+        run_case(c, max_noutputs[i], boost::trim_copy(affinities[j]), duration, first);
+        first = false;
+      }
+    }
+    std::cout << "\n  ]\n}" << std::endl;
+  }
+  catch(std::exception& e){
+    std::cerr << "gfdm_flowgraph_bench: " << e.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
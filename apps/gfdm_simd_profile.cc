@@ -0,0 +1,193 @@
+/* -*- c++ -*- */
+/* 
+ * Copyright 2016 Andrej Rode.
+ * 
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ * 
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Profile the fused SIMD kernels of gr-gfdm on this machine, like
+ * volk_profile does for VOLK.
+ *
+ * Every implementation this CPU supports is timed on the calls one GFDM
+ * frame makes: K subcarriers of M timeslots with overlap 2, for each (K, M)
+ * pair. The implementation with the lowest total time per kernel is written
+ * to $HOME/.gfdm/simd_config, which gr-gfdm reads on first use.
+ *
+ *   gfdm_simd_profile -K 16,64,128 -M 5,15
+ */
+
+#include <gfdm/simd_kernels.h>
+#include <gfdm/stage_timers.h>
+#include <boost/program_options.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/algorithm/string.hpp>
+#include <boost/lexical_cast.hpp>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <cstdlib>
+
+namespace po = boost::program_options;
+namespace simd = gr::gfdm::simd;
+typedef simd::gfdm_complex gfdm_complex;
+
+static std::vector<int>
+parse_int_list(const std::string& s)
+{
+  std::vector<std::string> fields;
+  boost::split(fields, s, boost::is_any_of(","));
+  std::vector<int> values;
+  for(size_t i = 0; i < fields.size(); i++){
+    values.push_back(boost::lexical_cast<int>(boost::trim_copy(fields[i])));
+  }
+  return values;
+}
+
+struct frame_t {
+  int K;
+  int M;
+  int overlap;
+  std::vector<gfdm_complex> block;  // K * M frequency domain samples
+  std::vector<gfdm_complex> sc;     // M subcarrier samples
+  std::vector<gfdm_complex> taps;   // overlap * M
+  std::vector<gfdm_complex> out;
+
+  frame_t(int K_, int M_)
+    : K(K_), M(M_), overlap(2), block(K_ * M_, gfdm_complex(0.5f, -0.25f)),
+      sc(M_, gfdm_complex(0.25f, 0.5f)), taps(2 * M_, gfdm_complex(0.75f, 0.125f)), out(M_) {}
+
+  //! One frame worth of calls to kernel, through the normal dispatch.
+  void
+  run(simd::kernel_t kernel)
+  {
+    for(int k = 0; k < K; k++){
+      if(kernel == simd::MULTIPLY_CIRCULAR_ADD){
+        for(int l = 0; l < overlap; l++){
+          simd::multiply_circular_add(&block[0], K * M, ((k + l) % K) * M, &sc[0], &taps[l * M], M);
+        }
+      }
+      else{
+        simd::gather_multiply_fold(&out[0], &block[0], K * M, k * M, &taps[0], M, overlap);
+      }
+    }
+  }
+};
+
+//! ns per frame, running for at least min_seconds.
+static double
+time_frame(frame_t& f, simd::kernel_t kernel, const std::string& impl, double min_seconds)
+{
+  simd::select_impl(kernel, impl);
+  for(int i = 0; i < 8; i++){
+    f.run(kernel);
+  }
+  long n_runs = 0;
+  long batch = 1;
+  const uint64_t start = gr::gfdm::stage_timers::monotonic_ns();
+  double elapsed = 0.0;
+  while(elapsed < min_seconds){
+    for(long i = 0; i < batch; i++){
+      f.run(kernel);
+    }
+    n_runs += batch;
+    batch *= 2;
+    elapsed = 1e-9 * double(gr::gfdm::stage_timers::monotonic_ns() - start);
+  }
+  return 1e9 * elapsed / n_runs;
+}
+
+int
+main(int argc, char **argv)
+{
+  std::string K_list;
+  std::string M_list;
+  double min_seconds;
+
+  po::options_description desc("gfdm_simd_profile [options]");
+  desc.add_options()
+    ("help,h", "show this help")
+    ("subcarriers,K", po::value<std::string>(&K_list)->default_value("16,64,128"), "comma separated subcarrier counts")
+    ("timeslots,M", po::value<std::string>(&M_list)->default_value("5,15"), "comma separated timeslot counts")
+    ("min-seconds", po::value<double>(&min_seconds)->default_value(0.1), "time per kernel, implementation and (K, M)")
+    ("dry-run", "print the results but don't write the config");
+
+  po::variables_map vm;
+  po::store(po::parse_command_line(argc, argv, desc), vm);
+  po::notify(vm);
+  if(vm.count("help")){
+    std::cout << desc << std::endl;
+    return 0;
+  }
+
+  const std::vector<int> Ks = parse_int_list(K_list);
+  const std::vector<int> Ms = parse_int_list(M_list);
+  const std::vector<std::string> impls = simd::available_impls();
+
+  std::stringstream config;
+  config << "# written by gfdm_simd_profile, <kernel> <implementation>\n";
+  std::cout << std::fixed << std::setprecision(1);
+  for(int kernel = 0; kernel < simd::N_KERNELS; kernel++){
+    const simd::kernel_t kt = simd::kernel_t(kernel);
+    std::cout << simd::kernel_name(kt) << " (ns per frame)" << std::endl;
+    std::vector<double> totals(impls.size(), 0.0);
+    for(size_t ik = 0; ik < Ks.size(); ik++){
+      for(size_t im = 0; im < Ms.size(); im++){
+        frame_t f(Ks[ik], Ms[im]);
+        std::cout << "  K=" << std::setw(4) << Ks[ik] << " M=" << std::setw(3) << Ms[im];
+        std::vector<double> ns(impls.size());
+        for(size_t a = 0; a < impls.size(); a++){
+          ns[a] = time_frame(f, kt, impls[a], min_seconds);
+          std::cout << "  " << impls[a] << " " << std::setw(9) << ns[a];
+        }
+        // relative to the generic one, so large frames don't dominate the choice.
+        for(size_t a = 0; a < impls.size(); a++){
+          totals[a] += ns[a] / ns[0];
+        }
+        std::cout << std::endl;
+      }
+    }
+    size_t best = 0;
+    for(size_t a = 1; a < impls.size(); a++){
+      if(totals[a] < totals[best]){
+        best = a;
+      }
+    }
+    std::cout << "  -> " << impls[best] << std::endl;
+    config << simd::kernel_name(kt) << " " << impls[best] << "\n";
+  }
+
+  if(vm.count("dry-run")){
+    return 0;
+  }
+  const boost::filesystem::path path(simd::config_filename());
+  try{
+    boost::filesystem::create_directories(path.parent_path());
+  }
+  catch(boost::filesystem::filesystem_error& e){
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+  std::ofstream f(path.string().c_str());
+  if(!f){
+    std::cerr << "can't write " << path.string() << std::endl;
+    return 1;
+  }
+  f << config.str();
+  std::cout << "wrote " << path.string() << std::endl;
+  return 0;
+}
@@ -0,0 +1,183 @@
+/* -*- c++ -*- */
+/* 
+ * Copyright 2016 Andrej Rode.
+ * 
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ * 
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Pre-generate FFTW wisdom for a set of GFDM numerologies.
+ *
+ * For every numerology K,M[,cp_len[,fft_len[,sync_fft_len]]] the kernels a
+ * flowgraph would use are created once: modulator kernel (subcarrier FFT,
+ * output IFFT), modulator_cc (subcarrier FFT, sync IFFT, fft_len output
+ * IFFT), transmitter_cvc (subcarrier FFT, output IFFT), receiver (input FFT,
+ * subcarrier IFFT/FFT), preamble generator and sync_cc (preamble IFFT,
+ * correlator FFT/IFFT). Their plans are measured and
+ * the wisdom is written to $HOME/.gr_fftw_wisdom, which gr-gfdm imports at
+ * startup. Run it as the user the flowgraphs run as, e.g.
+ *
+ *   gfdm_wisdom -n 64,15 -n 128,9,32 --effort patient
+ */
+
+#include <gfdm/modulator_kernel_cc.h>
+#include <gfdm/modulator_cc.h>
+#include <gfdm/transmitter_cvc.h>
+#include <gfdm/gfdm_receiver.h>
+#include <gfdm/preamble_generator.h>
+#include <gfdm/sync_cc.h>
+#include <gfdm/gfdm_utils.h>
+#include <gfdm/fft_plan.h>
+#include <boost/program_options.hpp>
+#include <boost/algorithm/string.hpp>
+#include <boost/lexical_cast.hpp>
+#include <iostream>
+#include <fstream>
+#include <cstdlib>
+
+namespace po = boost::program_options;
+
+struct numerology_t {
+  int K;
+  int M;
+  int cp_len;
+  int fft_len;
+  int sync_fft_len;
+};
+
+static numerology_t
+parse_numerology(const std::string& s)
+{
+  std::vector<std::string> fields;
+  boost::split(fields, s, boost::is_any_of(","));
+  if(fields.size() < 2 || fields.size() > 5){
+    throw std::invalid_argument("numerology '" + s + "' MUST be K,M[,cp_len[,fft_len[,sync_fft_len]]]");
+  }
+  std::vector<int> v;
+  for(size_t i = 0; i < fields.size(); i++){
+    v.push_back(boost::lexical_cast<int>(boost::trim_copy(fields[i])));
+  }
+  numerology_t n;
+  n.K = v[0];
+  n.M = v[1];
+  n.cp_len = v.size() > 2 ? v[2] : 16;
+  n.fft_len = v.size() > 3 ? v[3] : n.K * n.M;
+  n.sync_fft_len = v.size() > 4 ? v[4] : 2 * n.K;
+  return n;
+}
+
+static void
+read_numerologies(const std::string& filename, std::vector<std::string>& specs)
+{
+  std::ifstream f(filename.c_str());
+  if(!f){
+    throw std::runtime_error("can't open " + filename);
+  }
+  std::string line;
+  while(std::getline(f, line)){
+    line = boost::trim_copy(line.substr(0, line.find('#')));
+    if(!line.empty()){
+      specs.push_back(line);
+    }
+  }
+}
+
+static unsigned
+parse_effort(const std::string& effort)
+{
+  if(effort == "measure"){
+    return FFTW_MEASURE;
+  }
+  if(effort == "patient"){
+    return FFTW_PATIENT;
+  }
+  if(effort == "exhaustive"){
+    return FFTW_EXHAUSTIVE;
+  }
+  throw std::invalid_argument("effort MUST be measure, patient or exhaustive");
+}
+
+//! Create every kernel a flowgraph with this numerology plans FFTs for.
+static void
+plan_numerology(const numerology_t& n, double alpha)
+{
+  const int overlap = 2;
+  std::vector<gr_complex> taps;
+  gr::gfdm::rrc_filter_sparse(n.K * n.M, alpha, overlap, n.K, n.M).get_taps(taps);
+  taps.resize(n.M * overlap);
+  gr::gfdm::modulator_kernel_cc modulator(n.M, n.K, overlap, taps);
+  gr::gfdm::modulator_cc::sptr modulator_block = gr::gfdm::modulator_cc::make(n.K, n.M, alpha, n.fft_len, n.sync_fft_len);
+  gr::gfdm::transmitter_cvc::sptr transmitter = gr::gfdm::transmitter_cvc::make(n.K, n.M, overlap, alpha);
+  gr::gfdm::kernel::gfdm_receiver receiver(n.K, n.M, alpha, n.fft_len);
+
+  gr::gfdm::preamble_generator_sptr pregen = gr::gfdm::preamble_generator::make(n.K, alpha, n.sync_fft_len);
+  gr::gfdm::sync_cc::sptr sync = gr::gfdm::sync_cc::make(n.sync_fft_len, n.cp_len, n.fft_len, pregen);
+
+  // the kernels only run on ESTIMATE plans until this returns.
+  gr::gfdm::fft_plan::wait_for_upgrades();
+}
+
+int
+main(int argc, char **argv)
+{
+  std::vector<std::string> specs;
+  std::string config;
+  std::string effort;
+  double alpha;
+
+  po::options_description desc("gfdm_wisdom [options]");
+  desc.add_options()
+    ("help,h", "show this help")
+    ("numerology,n", po::value<std::vector<std::string> >(&specs)->composing(),
+     "K,M[,cp_len[,fft_len[,sync_fft_len]]], defaults cp_len=16, fft_len=K*M, sync_fft_len=2*K. May be repeated.")
+    ("config,c", po::value<std::string>(&config), "file with one numerology per line, '#' starts a comment")
+    ("effort", po::value<std::string>(&effort)->default_value("measure"), "measure, patient or exhaustive")
+    ("alpha", po::value<double>(&alpha)->default_value(0.35), "RRC roll-off, does not change the transforms");
+
+  try{
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+    if(vm.count("help")){
+      std::cout << desc << std::endl;
+      return 0;
+    }
+
+    if(!config.empty()){
+      read_numerologies(config, specs);
+    }
+    if(specs.empty()){
+      std::cerr << "no numerologies given, see --help" << std::endl;
+      return 1;
+    }
+    gr::gfdm::fft_plan::set_upgrade_effort(parse_effort(effort));
+
+    const char* home = std::getenv("HOME");
+    std::cout << "writing wisdom to " << (home ? home : ".") << "/.gr_fftw_wisdom" << std::endl;
+    for(size_t i = 0; i < specs.size(); i++){
+      const numerology_t n = parse_numerology(specs[i]);
+      std::cout << "K=" << n.K << " M=" << n.M << " cp_len=" << n.cp_len << " fft_len=" << n.fft_len
+                << " sync_fft_len=" << n.sync_fft_len << " ..." << std::flush;
+      plan_numerology(n, alpha);
+      std::cout << " done" << std::endl;
+    }
+  }
+  catch(std::exception& e){
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,47 @@
+# http://tim.klingt.org/code/browser/aux/cmake/modules/FindFFTW3f.cmake
+# Modified to use pkg config and use standard var names
+
+#
+# Find the single-precision FFTW3 includes and libraries
+#
+# This module defines
+# FFTW3F_INCLUDE_DIRS, where to find fftw3.h
+# FFTW3F_LIBRARIES, the libraries to link against to use FFTW3f.
+# FFTW3F_THREADS_LIBRARIES, the threaded FFTW3f library, if available.
+# FFTW3F_FOUND, If false, do not try to use FFTW3f.
+
+INCLUDE(FindPkgConfig)
+PKG_CHECK_MODULES(PC_FFTW3F "fftw3f >= 3.0")
+
+FIND_PATH(FFTW3F_INCLUDE_DIRS
+    NAMES fftw3.h
+    HINTS $ENV{FFTW3_DIR}/include
+    ${PC_FFTW3F_INCLUDE_DIR}
+    PATHS
+    /usr/local/include
+    /usr/include
+)
+
+FIND_LIBRARY(FFTW3F_LIBRARIES
+    NAMES fftw3f libfftw3f
+    HINTS $ENV{FFTW3_DIR}/lib
+    ${PC_FFTW3F_LIBDIR}
+    PATHS
+    /usr/local/lib
+    /usr/lib
+    /usr/lib64
+)
+
+FIND_LIBRARY(FFTW3F_THREADS_LIBRARIES
+    NAMES fftw3f_threads libfftw3f_threads
+    HINTS $ENV{FFTW3_DIR}/lib
+    ${PC_FFTW3F_LIBDIR}
+    PATHS
+    /usr/local/lib
+    /usr/lib
+    /usr/lib64
+)
+
+INCLUDE(FindPackageHandleStandardArgs)
+FIND_PACKAGE_HANDLE_STANDARD_ARGS(FFTW3F DEFAULT_MSG FFTW3F_LIBRARIES FFTW3F_INCLUDE_DIRS)
+MARK_AS_ADVANCED(FFTW3F_LIBRARIES FFTW3F_INCLUDE_DIRS FFTW3F_THREADS_LIBRARIES)
@@ -24,7 +24,21 @@ FIND_LIBRARY(
           /usr/lib64
 )
 
+# the kernels alone, for applications without GNU Radio
+FIND_LIBRARY(
+    GFDM_KERNELS_LIBRARIES
+    NAMES gfdm-kernels
+    HINTS $ENV{GFDM_DIR}/lib
+        ${PC_GFDM_LIBDIR}
+    PATHS ${CMAKE_INSTALL_PREFIX}/lib
+          ${CMAKE_INSTALL_PREFIX}/lib64
+          /usr/local/lib
+          /usr/local/lib64
+          /usr/lib
+          /usr/lib64
+)
+
 INCLUDE(FindPackageHandleStandardArgs)
 FIND_PACKAGE_HANDLE_STANDARD_ARGS(GFDM DEFAULT_MSG GFDM_LIBRARIES GFDM_INCLUDE_DIRS)
-MARK_AS_ADVANCED(GFDM_LIBRARIES GFDM_INCLUDE_DIRS)
+MARK_AS_ADVANCED(GFDM_LIBRARIES GFDM_KERNELS_LIBRARIES GFDM_INCLUDE_DIRS)
 
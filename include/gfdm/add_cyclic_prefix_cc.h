@@ -22,6 +22,7 @@
 #ifndef INCLUDED_GFDM_ADD_CYCLIC_PREFIX_CC_H
 #define INCLUDED_GFDM_ADD_CYCLIC_PREFIX_CC_H
 
+#include <gfdm/kernels_api.h>
 #include <complex>
 #include <vector>
 #include <boost/shared_ptr.hpp>
@@ -32,25 +33,36 @@ namespace gr {
     /*!
      * \brief Kernel adds cyclic prefix to GFDM frame and applies block pinching window.
      *
+     * With cyclic_suffix set, every frame is extended by a ramp_len cyclic suffix
+     * which carries the back ramp. The suffix is overlap-added onto the front ramp
+     * of the following frame, thus a frame still occupies block_len + cp_len samples
+     * but the ramps no longer eat into the cyclic prefix.
      */
-//    class GFDM_API add_cyclic_prefix_cc
-    class add_cyclic_prefix_cc
+    class GFDM_KERNELS_API add_cyclic_prefix_cc
     {
     public:
       typedef std::complex<float> gfdm_complex;
       typedef boost::shared_ptr<add_cyclic_prefix_cc> sptr;
 
-      add_cyclic_prefix_cc(int ramp_len, int cp_len, int block_len, std::vector<gfdm_complex> window_taps);
+      add_cyclic_prefix_cc(int ramp_len, int cp_len, int block_len, std::vector<gfdm_complex> window_taps, bool cyclic_suffix=false);
       ~add_cyclic_prefix_cc();
       void generic_work(gfdm_complex* p_out, const gfdm_complex* p_in);
+      //! p_frame holds the block at p_frame + cp_len already, fill in the CP and apply ramps in place.
+      void add_cyclic_prefix_in_place(gfdm_complex* p_frame);
       int block_size(){ return d_block_len;};
       int frame_size(){ return block_size() + d_cp_len;};
+      bool cyclic_suffix(){ return d_cyclic_suffix;};
+      //! Drop the suffix of the previous frame, e.g. at the start of a burst.
+      void reset_overlap();
     private:
       int d_ramp_len;
       int d_cp_len;
       int d_block_len;
       gfdm_complex* d_front_ramp;
       gfdm_complex* d_back_ramp;
+      bool d_cyclic_suffix;
+      gfdm_complex* d_overlap;
+      gfdm_complex* d_suffix;
     };
 
   } // namespace gfdm
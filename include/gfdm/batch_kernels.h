@@ -0,0 +1,95 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2016 Andrej Rode.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_GFDM_BATCH_KERNELS_H
+#define INCLUDED_GFDM_BATCH_KERNELS_H
+
+#include <gfdm/kernels_api.h>
+#include <gfdm/modulator_kernel_cc.h>
+#include <gfdm/gfdm_receiver.h>
+#include <complex>
+#include <vector>
+#include <boost/shared_ptr.hpp>
+
+namespace gr {
+  namespace gfdm {
+
+    /*!
+     * \brief Modulate many GFDM blocks per call, e.g. for offline dataset generation.
+     *  Frames are split into nthreads contiguous chunks, each one modulated by
+     *  its own modulator_kernel_cc. The buffers hold n_frames frames back to back.
+     */
+    class GFDM_KERNELS_API batch_modulator
+    {
+    public:
+      typedef std::complex<float> gfdm_complex;
+
+      batch_modulator(int n_timeslots, int n_subcarriers, int overlap,
+                      std::vector<gfdm_complex> frequency_taps, int nthreads = 1);
+
+      //! samples per frame, n_subcarriers * n_timeslots both in and out.
+      int block_size() const { return d_block_size;};
+      int nthreads() const { return d_kernels.size();};
+      //! n_frames * block_size() symbols to as many samples, out may equal in.
+      void modulate(gfdm_complex* out, const gfdm_complex* in, int n_frames);
+
+    private:
+      int d_block_size;
+      std::vector<boost::shared_ptr<modulator_kernel_cc> > d_kernels;
+
+      void run_chunk(int kernel, gfdm_complex* out, const gfdm_complex* in, int first, int last);
+    };
+
+    /*!
+     * \brief Demodulate many GFDM blocks per call, optionally with SIC.
+     *  Threads as batch_modulator. Reads fft_len samples and writes
+     *  n_subcarriers * n_timeslots symbols per frame.
+     */
+    class GFDM_KERNELS_API batch_receiver
+    {
+    public:
+      typedef std::complex<float> gfdm_complex;
+
+      batch_receiver(int n_subcarriers, int n_timeslots, double filter_alpha, int fft_len, int nthreads = 1);
+
+      int fft_len() const { return d_fft_len;};
+      int block_size() const { return d_block_size;};
+      int nthreads() const { return d_kernels.size();};
+      //! out may only equal in if fft_len() == block_size().
+      void demodulate(gfdm_complex* out, const gfdm_complex* in, int n_frames);
+      //! ic_iter SIC iterations against the nearest of constellation_points, see kernel::gfdm_receiver.
+      void demodulate_ic(gfdm_complex* out, const gfdm_complex* in, int n_frames, int ic_iter,
+                         const std::vector<gfdm_complex>& constellation_points);
+
+    private:
+      int d_fft_len;
+      int d_block_size;
+      std::vector<boost::shared_ptr<kernel::gfdm_receiver> > d_kernels;
+
+      void run(gfdm_complex* out, const gfdm_complex* in, int n_frames, int ic_iter,
+               const std::vector<gfdm_complex>* constellation_points);
+      void run_chunk(int kernel, gfdm_complex* out, const gfdm_complex* in, int first, int last,
+                     int ic_iter, const std::vector<gfdm_complex>* constellation_points);
+    };
+
+  } // namespace gfdm
+} // namespace gr
+
+#endif /* INCLUDED_GFDM_BATCH_KERNELS_H */
@@ -32,6 +32,9 @@ namespace gr {
      * \brief Add Cyclic Prefix to GFDM block and apply block pinching (W-GFDM).
      * \ingroup gfdm
      *
+     * If cyclic_suffix is set, a ramp_len cyclic suffix is appended to every block
+     * and overlap-added onto the next frame's prefix. The output rate stays
+     * (block_len + cp_length) / block_len.
      */
     class GFDM_API cyclic_prefixer_cc : virtual public gr::block
     {
@@ -46,7 +49,7 @@ namespace gr {
        * class. gfdm::cyclic_prefixer_cc::make is the public interface for
        * creating new instances.
        */
-      static sptr make(int cp_length, int ramp_len, int block_len, std::vector<gr_complex> window_taps);
+      static sptr make(int cp_length, int ramp_len, int block_len, std::vector<gr_complex> window_taps, bool cyclic_suffix=false);
     };
 
   } // namespace gfdm
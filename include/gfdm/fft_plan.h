@@ -0,0 +1,111 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2016 Andrej Rode.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef INCLUDED_GFDM_FFT_PLAN_H
+#define INCLUDED_GFDM_FFT_PLAN_H
+
+#include <gfdm/kernels_api.h>
+#include <complex>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <fftw3.h>
+
+namespace gr {
+  namespace gfdm {
+
+    /*!
+     * \brief Complex FFTW plan bound to one input and output buffer.
+     *  Construction never measures. If the wisdom file already holds a plan
+     *  of the upgrade effort for this size it is used right away, otherwise
+     *  the kernel starts on an FFTW_ESTIMATE plan and a background thread
+     *  plans with the upgrade effort on scratch buffers. execute() switches
+     *  to the better plan atomically as soon as it is ready and the new
+     *  wisdom is saved to $HOME/.gr_fftw_wisdom, so the next start gets
+     *  measured plans immediately.
+     *
+     *  Transforms of at least threads_min_len() points are planned with
+     *  threads() FFTW threads, smaller ones with one.
+     *
+     *  All planning is serialized with one planner mutex, the library's own
+     *  unless set_planner_mutex() shares another one, e.g. GNU Radio's.
+     */
+    class GFDM_KERNELS_API fft_plan
+    {
+    public:
+      typedef std::complex<float> gfdm_complex;
+
+      /*!
+       * \param fft_len transform size.
+       * \param in input buffer, SIMD aligned (volk_malloc) to allow the upgrade.
+       * \param out output buffer, may equal in.
+       * \param forward FFTW_FORWARD if true, FFTW_BACKWARD otherwise. Unnormalized.
+       */
+      fft_plan(int fft_len, gfdm_complex* in, gfdm_complex* out, bool forward);
+      ~fft_plan();
+
+      void execute();
+      int fft_len() const { return d_fft_len;};
+      //! FFTW threads this transform runs on.
+      int nthreads() const { return d_nthreads;};
+      //! true once execute() runs on a plan of the upgrade effort.
+      bool upgraded() const;
+
+      /*!
+       * Planner flags for upgrades, FFTW_MEASURE unless GFDM_FFTW_EFFORT is set
+       * to estimate, measure, patient or exhaustive. FFTW_ESTIMATE disables upgrades.
+       */
+      static void set_upgrade_effort(unsigned flags);
+      static unsigned upgrade_effort();
+      //! Block until all queued upgrades are done, e.g. before timing kernels.
+      static void wait_for_upgrades();
+
+      /*!
+       * FFTW threads for large transforms. Defaults to the number of cores,
+       * at most 4, or GFDM_FFTW_THREADS. Always 1 if FFTW has no thread support.
+       * Only plans created afterwards are affected.
+       */
+      static void set_threads(int nthreads);
+      static int threads();
+      //! Smallest fft_len planned with threads(), 65536 or GFDM_FFTW_THREADS_MIN_LEN.
+      static void set_threads_min_len(int fft_len);
+      static int threads_min_len();
+      //! Threads a transform of fft_len points is planned with, also for gr::fft plans.
+      static int threads_for(int fft_len);
+      /*!
+       * Serialize planning with mutex from now on, for processes that plan with
+       * FFTW elsewhere too. Call before the first plan is created.
+       */
+      static void set_planner_mutex(boost::mutex& mutex);
+
+      struct state;
+    private:
+      int d_fft_len;
+      int d_nthreads;
+      gfdm_complex* d_in;
+      gfdm_complex* d_out;
+      boost::shared_ptr<state> d_state;
+    };
+
+  } // namespace gfdm
+} // namespace gr
+
+#endif /* INCLUDED_GFDM_FFT_PLAN_H */
+
@@ -0,0 +1,83 @@
+/* -*- c++ -*- */
+/* 
+ * Copyright 2016 Andrej Rode.
+ * 
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ * 
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+
+#ifndef INCLUDED_GFDM_FRAME_RECEIVER_CC_H
+#define INCLUDED_GFDM_FRAME_RECEIVER_CC_H
+
+#include <gfdm/api.h>
+#include <gnuradio/block.h>
+#include <gnuradio/digital/constellation.h>
+
+namespace gr {
+  namespace gfdm {
+
+    /*!
+     * \brief Demodulate GFDM frames straight from a sync-tagged stream.
+     * \ingroup gfdm
+     *
+     * Replaces remove_prefix_cc -> advanced_receiver_cc. For every
+     * gfdm_sync_tag_key tag (placed at the preamble start by sync_cc) the
+     * fft_len data samples behind preamble and CP are demodulated in place
+     * from the input buffer, including ic_iter SIC iterations. Each frame
+     * yields nsubcarrier*ntimeslots symbols tagged with gfdm_len_tag_key.
+     * Frames that are not complete yet are kept in the input buffer until
+     * the next call.
+     *
+     * With sync_messages set, frame starts come from the "sync" message
+     * input instead of stream tags. Connect it to the "sync" port of a
+     * sync_cc that reads the same sample stream, so sync_cc does not have
+     * to copy the samples to a stream output. Input is only consumed up to
+     * the "processed" position sync_cc has announced.
+     */
+    class GFDM_API frame_receiver_cc : virtual public gr::block
+    {
+     public:
+      typedef boost::shared_ptr<frame_receiver_cc> sptr;
+
+      /*!
+       * \brief Return a shared_ptr to a new instance of gfdm::frame_receiver_cc.
+       *
+       * To avoid accidental use of raw pointers, gfdm::frame_receiver_cc's
+       * constructor is in a private implementation
+       * class. gfdm::frame_receiver_cc::make is the public interface for
+       * creating new instances.
+       */
+      static sptr make(
+          int nsubcarrier,
+          int ntimeslots,
+          double filter_alpha,
+          int fft_len,
+          int cp_length,
+          int sync_fft_len,
+          int ic_iter,
+          gr::digital::constellation_sptr constellation,
+          const std::string& gfdm_sync_tag_key = "gfdm_block",
+          const std::string& gfdm_len_tag_key = "gfdm_frame",
+          bool sync_messages = false);
+      virtual void set_ic(int ic_iter) = 0;
+    };
+
+  } // namespace gfdm
+} // namespace gr
+
+#endif /* INCLUDED_GFDM_FRAME_RECEIVER_CC_H */
+
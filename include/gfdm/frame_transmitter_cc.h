@@ -0,0 +1,68 @@
+/* -*- c++ -*- */
+/* 
+ * Copyright 2016 Andrej Rode.
+ * 
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ * 
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+
+#ifndef INCLUDED_GFDM_FRAME_TRANSMITTER_CC_H
+#define INCLUDED_GFDM_FRAME_TRANSMITTER_CC_H
+
+#include <gfdm/api.h>
+#include <gnuradio/block.h>
+#include <gfdm/preamble_generator.h>
+
+namespace gr {
+  namespace gfdm {
+
+    /*!
+     * \brief Frame, modulate and cyclic prefix GFDM blocks in one pass.
+     * \ingroup gfdm
+     *
+     * Replaces framer_cc -> modulator -> cyclic_prefixer_cc. Consumes
+     * n_timeslots*n_subcarriers data symbols (time slot major, as framer_cc
+     * expects them) per frame and produces
+     * [cp | preamble] [cp | GFDM block] with ramps applied to the data part.
+     * The preamble part is omitted if no preamble_generator is given.
+     * The modulator writes straight into the output buffer behind the CP.
+     * Each frame start is tagged with len_tag_key (frame length) unless it is empty.
+     */
+    class GFDM_API frame_transmitter_cc : virtual public gr::block
+    {
+     public:
+      typedef boost::shared_ptr<frame_transmitter_cc> sptr;
+
+      /*!
+       * \brief Return a shared_ptr to a new instance of gfdm::frame_transmitter_cc.
+       *
+       * To avoid accidental use of raw pointers, gfdm::frame_transmitter_cc's
+       * constructor is in a private implementation
+       * class. gfdm::frame_transmitter_cc::make is the public interface for
+       * creating new instances.
+       */
+      static sptr make(int n_timeslots, int n_subcarriers, int overlap, std::vector<gr_complex> frequency_taps,
+                       int cp_length, int ramp_len, std::vector<gr_complex> window_taps,
+                       gr::gfdm::preamble_generator_sptr preamble_generator,
+                       const std::string& len_tag_key = "gfdm_frame");
+    };
+
+  } // namespace gfdm
+} // namespace gr
+
+#endif /* INCLUDED_GFDM_FRAME_TRANSMITTER_CC_H */
+
@@ -20,46 +20,70 @@
  * Boston, MA 02110-1301, USA.
  */
 
-#ifndef INCLUDED_GFDM_RECEIVER_H
-#define INCLUDED_GFDM_RECEIVER_H
-#endif
+#ifndef INCLUDED_GFDM_GFDM_RECEIVER_H
+#define INCLUDED_GFDM_GFDM_RECEIVER_H
 
-#include <gfdm/api.h>
+#include <gfdm/kernels_api.h>
 #include <gfdm/gfdm_utils.h>
-#include <gnuradio/fft/fft.h>
-#include <gnuradio/gr_complex.h>
-#include <volk/volk.h>
+#include <gfdm/stage_timers.h>
+#include <gfdm/fft_plan.h>
+#include <complex>
+#include <vector>
 
 namespace gr {
   namespace gfdm {
     namespace kernel {
       
-      class GFDM_API gfdm_receiver
+      class GFDM_KERNELS_API gfdm_receiver
       {
+        public:
+          typedef std::complex<float> gfdm_complex;
+
         protected:
           int d_nsubcarrier;
           int d_ntimeslots;
           int d_filter_width;
           int d_N;
           int d_fft_len;
-          std::vector<gr_complex> d_filter_taps;
-          std::vector< std::vector<gr_complex> > d_sc_fdomain;
-          std::vector< std::vector<gr_complex> > d_sc_symbols;
-          fft::fft_complex *d_in_fft;
-          gr_complex *d_in_fft_in;
-          gr_complex *d_in_fft_out;
-          fft::fft_complex *d_sc_ifft;
-          gr_complex *d_sc_ifft_in;
-          gr_complex *d_sc_ifft_out;
+          std::vector<gfdm_complex> d_filter_taps;
+          std::vector<gfdm_complex> d_rotated_filter_taps;
+          std::vector< std::vector<gfdm_complex> > d_sc_fdomain;
+          std::vector< std::vector<gfdm_complex> > d_sc_symbols;
+          fft_plan *d_in_fft;
+          gfdm_complex *d_in_fft_in;
+          gfdm_complex *d_in_fft_out;
+          fft_plan *d_sc_ifft;
+          gfdm_complex *d_sc_ifft_in;
+          gfdm_complex *d_sc_ifft_out;
+          std::vector<gfdm_complex> d_ic_filter_taps;
+          fft_plan *d_sc_fft;
+          gfdm_complex *d_sc_fft_in;
+          gfdm_complex *d_sc_fft_out;
+          stage_timers d_timers;
 
-          void filter_superposition(std::vector< std::vector<gr_complex> > &out, const gr_complex in[]);
-          void demodulate_subcarrier(std::vector< std::vector<gr_complex> > &out, std::vector< std::vector<gr_complex> > &sc_fdomain);
-          void serialize_output(gr_complex out[], std::vector< std::vector<gr_complex> > &sc_symbols);
+          void filter_superposition(std::vector< std::vector<gfdm_complex> > &out, const gfdm_complex in[]);
+          void demodulate_subcarrier(std::vector< std::vector<gfdm_complex> > &out, std::vector< std::vector<gfdm_complex> > &sc_fdomain);
+          void serialize_output(gfdm_complex out[], std::vector< std::vector<gfdm_complex> > &sc_symbols);
+          void map_sc_symbols(std::vector< std::vector<gfdm_complex> > &sc_symbols, const std::vector<gfdm_complex> &constellation_points);
+          void remove_sc_interference(std::vector< std::vector<gfdm_complex> > &sc_symbols, std::vector< std::vector<gfdm_complex> > &sc_fdomain);
 
         public:
+          //! sc_ifft includes the re-demodulation of every SIC iteration. Filtering and
+          //! superposition are one fused kernel, STAGE_FILTER covers both.
+          enum stage_t { STAGE_INPUT_FFT, STAGE_FILTER, STAGE_SC_IFFT,
+                         STAGE_SIC_DECISION, STAGE_SIC_CANCEL, STAGE_SERIALIZE, N_STAGES };
+
           gfdm_receiver(int nsubcarrier, int ntimeslots, double filter_alpha, int fft_len);
           ~gfdm_receiver();
-          void gfdm_work(gr_complex out[], const gr_complex in[], int ninputitems, int noutputitems);
+          void gfdm_work(gfdm_complex out[], const gfdm_complex in[], int ninputitems, int noutputitems);
+          /*!
+           * Demodulate one block of fft_len samples with ic_iter iterations of
+           * successive interference cancellation. Each iteration decides every
+           * symbol for the nearest of constellation_points.
+           */
+          void gfdm_work_ic(gfdm_complex out[], const gfdm_complex in[], int ic_iter, const std::vector<gfdm_complex> &constellation_points);
+          //! Time per frame spent in each stage_t, empty unless built with ENABLE_STAGE_TIMERS.
+          stage_timers& stage_timing(){ return d_timers;};
           
 
 
@@ -68,4 +92,6 @@ namespace gr {
   } /* namespace gfdm */
 } /* namespace gr */
 
+#endif /* INCLUDED_GFDM_GFDM_RECEIVER_H */
+
 
@@ -23,20 +23,37 @@
 #ifndef INCLUDED_GFDM_UTILS_H
 #define INCLUDED_GFDM_UTILS_H
 
-#include <gfdm/api.h>
-#include <gnuradio/filter/firdes.h>
-#include <gnuradio/fft/fft.h>
+#include <gfdm/kernels_api.h>
+#include <complex>
+#include <vector>
 
 namespace gr {
   namespace gfdm {
 
-      class GFDM_API rrc_filter_sparse {
+      /*!
+       * \brief Root raised cosine taps, same design as gr::filter::firdes::root_raised_cosine.
+       *  ntaps is rounded up to the next odd number.
+       */
+      GFDM_KERNELS_API std::vector<float> root_raised_cosine(double gain, double sampling_freq,
+                                                             double symbol_rate, double alpha, int ntaps);
+
+      /*!
+       * \brief Reorder one block of time slot major symbols p_in[m * nsubcarrier + k]
+       *  to the subcarrier major order p_out[k * ntimeslots + m] the modulator expects.
+       */
+      GFDM_KERNELS_API void transpose_symbols(std::complex<float>* p_out, const std::complex<float>* p_in,
+                                              int nsubcarrier, int ntimeslots);
+
+      class GFDM_KERNELS_API rrc_filter_sparse {
+        public:
+          typedef std::complex<float> gfdm_complex;
+
         private:
-          std::vector<gr_complex> d_filter_taps;
+          std::vector<gfdm_complex> d_filter_taps;
 
         public:
           rrc_filter_sparse(int ntaps, double alpha, int filter_width, int nsubcarrier, int ntimeslots);
-          void get_taps(std::vector<gr_complex> &out);
+          void get_taps(std::vector<gfdm_complex> &out);
           ~rrc_filter_sparse();
       };
 
@@ -0,0 +1,46 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2016 Andrej Rode.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_GFDM_KERNELS_API_H
+#define INCLUDED_GFDM_KERNELS_API_H
+
+/*
+ * Export macro of the gfdm-kernels library. The kernels do not depend on
+ * GNU Radio, so this header must not include any of its headers.
+ */
+
+#if defined(_MSC_VER)
+#  define GFDM_KERNELS_ATTR_EXPORT __declspec(dllexport)
+#  define GFDM_KERNELS_ATTR_IMPORT __declspec(dllimport)
+#elif defined(__GNUC__) && __GNUC__ >= 4
+#  define GFDM_KERNELS_ATTR_EXPORT __attribute__((visibility("default")))
+#  define GFDM_KERNELS_ATTR_IMPORT __attribute__((visibility("default")))
+#else
+#  define GFDM_KERNELS_ATTR_EXPORT
+#  define GFDM_KERNELS_ATTR_IMPORT
+#endif
+
+#ifdef gfdm_kernels_EXPORTS
+#  define GFDM_KERNELS_API GFDM_KERNELS_ATTR_EXPORT
+#else
+#  define GFDM_KERNELS_API GFDM_KERNELS_ATTR_IMPORT
+#endif
+
+#endif /* INCLUDED_GFDM_KERNELS_API_H */
@@ -22,10 +22,12 @@
 #ifndef INCLUDED_GFDM_MODULATOR_KERNEL_CC_H
 #define INCLUDED_GFDM_MODULATOR_KERNEL_CC_H
 
+#include <gfdm/kernels_api.h>
+#include <gfdm/stage_timers.h>
 #include <complex>
 #include <vector>
 #include <boost/shared_ptr.hpp>
-#include <fftw3.h>
+#include <gfdm/fft_plan.h>
 
 namespace gr {
   namespace gfdm {
@@ -36,16 +38,20 @@ namespace gr {
      *  This class initializes and performs all operations necessary to modulate a GFDM block.
      *
      */
-    class modulator_kernel_cc
+    class GFDM_KERNELS_API modulator_kernel_cc
     {
     public:
       typedef std::complex<float> gfdm_complex;
       typedef boost::shared_ptr<modulator_kernel_cc> sptr;
+      //! Filtering and superposition are one fused kernel, STAGE_FILTER covers both.
+      enum stage_t { STAGE_SUB_FFT, STAGE_FILTER, STAGE_IFFT, N_STAGES };
 
       modulator_kernel_cc(int n_timeslots, int n_subcarriers, int overlap, std::vector<gfdm_complex> frequency_taps);
       ~modulator_kernel_cc();
       void generic_work(gfdm_complex* p_out, const gfdm_complex* p_in);
       int block_size(){return d_n_subcarriers * d_n_timeslots;};
+      //! Time per frame spent in each stage_t, empty unless built with ENABLE_STAGE_TIMERS.
+      stage_timers& stage_timing(){ return d_timers;};
     private:
       int d_n_timeslots;
       int d_n_subcarriers;
@@ -53,15 +59,13 @@ namespace gr {
       int d_overlap;
       gfdm_complex* d_filter_taps;
 
-      fftwf_plan initialize_fft(gfdm_complex* out_buf, gfdm_complex* in_buf, const int fft_size, bool forward);
-
       gfdm_complex* d_sub_fft_in;
       gfdm_complex* d_sub_fft_out;
-      fftwf_plan d_sub_fft_plan;
-      gfdm_complex* d_filtered;
+      fft_plan* d_sub_fft;
       gfdm_complex* d_ifft_in;
       gfdm_complex* d_ifft_out;
-      fftwf_plan d_ifft_plan;
+      fft_plan* d_ifft;
+      stage_timers d_timers;
 
       // DEBUG function
       const void print_vector(const gfdm_complex* v, const int size);
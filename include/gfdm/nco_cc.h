@@ -0,0 +1,67 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2016 Andrej Rode.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef INCLUDED_GFDM_NCO_CC_H
+#define INCLUDED_GFDM_NCO_CC_H
+
+#include <gfdm/kernels_api.h>
+#include <complex>
+#include <boost/shared_ptr.hpp>
+
+namespace gr {
+  namespace gfdm {
+
+    /*!
+     * \brief Phase-continuous NCO to frequency shift sample streams.
+     *  Phase is kept across calls and frequency changes, samples are rotated
+     *  in one vectorized pass without per-sample transcendentals.
+     *
+     */
+    class GFDM_KERNELS_API nco_cc
+    {
+    public:
+      typedef std::complex<float> gfdm_complex;
+      typedef boost::shared_ptr<nco_cc> sptr;
+
+      /*!
+       * \param frequency normalized frequency in cycles per sample.
+       */
+      nco_cc(double frequency = 0.0);
+      ~nco_cc();
+
+      //! p_out[i] = p_in[i] * exp(j * (phase + 2 * pi * frequency * i)), advances phase by n_items.
+      void rotate(gfdm_complex* p_out, const gfdm_complex* p_in, int n_items);
+      void set_frequency(double frequency);
+      double frequency(){ return d_frequency;};
+      void set_phase(double phase);
+      double phase(){ return std::arg(d_phasor);};
+      void reset(){ set_phase(0.0);};
+    private:
+      double d_frequency;
+      gfdm_complex d_phase_incr;
+      gfdm_complex d_phasor;
+    };
+
+  } // namespace gfdm
+} // namespace gr
+
+#endif /* INCLUDED_GFDM_NCO_CC_H */
+
@@ -0,0 +1,80 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2016 Andrej Rode.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef INCLUDED_GFDM_PREAMBLE_CORRELATOR_CC_H
+#define INCLUDED_GFDM_PREAMBLE_CORRELATOR_CC_H
+
+#include <gfdm/kernels_api.h>
+#include <complex>
+#include <vector>
+#include <boost/shared_ptr.hpp>
+#include <gfdm/fft_plan.h>
+
+namespace gr {
+  namespace gfdm {
+
+    /*!
+     * \brief Cross-correlate a sample stream against a known preamble.
+     *  Uses FFT-based overlap-save against the conjugate preamble spectrum,
+     *  so the cost per lag is O(log(fft_len)) instead of O(preamble_len).
+     *
+     *  p_out[i] = 1/preamble_len * sum_k conj(preamble[k]) * p_in[i + k]
+     */
+    class GFDM_KERNELS_API preamble_correlator_cc
+    {
+    public:
+      typedef std::complex<float> gfdm_complex;
+      typedef boost::shared_ptr<preamble_correlator_cc> sptr;
+
+      /*!
+       * \param preamble_len length of the time domain preamble.
+       * \param preamble_spectrum conj(FFT(preamble)) zero padded to fft_len (fft_len = preamble_spectrum.size()).
+       */
+      preamble_correlator_cc(int preamble_len, std::vector<gfdm_complex> preamble_spectrum);
+      ~preamble_correlator_cc();
+
+      /*!
+       * Compute n_lags correlation values. Reads n_lags + preamble_len - 1 items from p_in.
+       */
+      void generic_work(gfdm_complex* p_out, const gfdm_complex* p_in, int n_lags);
+      int preamble_len(){ return d_preamble_len;};
+      int fft_len(){ return d_fft_len;};
+      int hop_len(){ return d_fft_len - d_preamble_len + 1;};
+
+      //! Suggest an overlap-save FFT size for n_lags lags per call.
+      static int suggest_fft_len(int preamble_len, int n_lags);
+    private:
+      int d_preamble_len;
+      int d_fft_len;
+      gfdm_complex* d_preamble_spectrum;
+
+      gfdm_complex* d_fft_in;
+      gfdm_complex* d_fft_out;
+      fft_plan* d_fft;
+      gfdm_complex* d_ifft_out;
+      fft_plan* d_ifft;
+    };
+
+  } // namespace gfdm
+} // namespace gr
+
+#endif /* INCLUDED_GFDM_PREAMBLE_CORRELATOR_CC_H */
+
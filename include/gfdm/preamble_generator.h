@@ -22,12 +22,12 @@
 #ifndef INCLUDED_GFDM_PREAMBLE_GENERATOR_H
 #define INCLUDED_GFDM_PREAMBLE_GENERATOR_H
 
-#include <gfdm/api.h>
+#include <gfdm/kernels_api.h>
 #include <gfdm/gfdm_utils.h>
-#include <gnuradio/fft/fft.h>
-#include <gnuradio/gr_complex.h>
 #include <boost/enable_shared_from_this.hpp>
-#include <volk/volk.h>
+#include <boost/shared_ptr.hpp>
+#include <complex>
+#include <vector>
 
 namespace gr {
   namespace gfdm {
@@ -40,18 +40,19 @@ namespace gr {
     class preamble_generator;
     typedef boost::shared_ptr<preamble_generator> preamble_generator_sptr;
 
-    class GFDM_API preamble_generator
+    class GFDM_KERNELS_API preamble_generator
       : public boost::enable_shared_from_this<preamble_generator>
     {
     public:
       typedef boost::shared_ptr<preamble_generator> sptr;
+      typedef std::complex<float> gfdm_complex;
       preamble_generator(int nsubcarrier,  double filter_alpha, int sync_fft_len);
       ~preamble_generator();
-      std::vector<gr_complex> get_preamble() 
+      std::vector<gfdm_complex> get_preamble() 
       {
         return d_samp_preamble;
       }
-      std::vector<gr_complex> get_symbol_seq() 
+      std::vector<gfdm_complex> get_symbol_seq() 
       {
         return d_symbols;
       }
@@ -63,10 +64,15 @@ namespace gr {
       {
         return d_sync_fft_len;
       }
+      /*!
+       * \brief conj(FFT(preamble)) with the preamble zero padded to fft_len.
+       * Reference spectrum for FFT-based cross-correlation against the preamble.
+       */
+      std::vector<gfdm_complex> get_preamble_spectrum(int fft_len);
       static sptr make(int nsubcarrier, double filter_alpha, int sync_fft_len);
     private:
-      std::vector<gr_complex> d_samp_preamble;
-      std::vector<gr_complex> d_symbols;
+      std::vector<gfdm_complex> d_samp_preamble;
+      std::vector<gfdm_complex> d_symbols;
       int d_sync_fft_len;
 
     };
@@ -0,0 +1,82 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2016 Andrej Rode.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_GFDM_SIMD_KERNELS_H
+#define INCLUDED_GFDM_SIMD_KERNELS_H
+
+#include <gfdm/kernels_api.h>
+#include <complex>
+#include <string>
+#include <vector>
+
+namespace gr {
+  namespace gfdm {
+    namespace simd {
+
+      /*
+       * Fused GFDM kernels with one implementation per instruction set
+       * (generic, sse3, avx2, avx512). Like VOLK, every kernel dispatches to
+       * the fastest implementation the CPU supports. gfdm_simd_profile times
+       * all of them and writes its choice to config_filename(), which is read
+       * on first use. GFDM_SIMD_ARCH=<impl> forces one implementation for all
+       * kernels.
+       */
+
+      typedef std::complex<float> gfdm_complex;
+
+      enum kernel_t { MULTIPLY_CIRCULAR_ADD, GATHER_MULTIPLY_FOLD, N_KERNELS };
+
+      //! Largest fold gather_multiply_fold accepts.
+      const int max_fold = 16;
+
+      /*!
+       * target[(target_offset + i) % target_len] += in[i] * taps[i] for 0 <= i < n.
+       * Filtering and superposition of one subcarrier in the modulators.
+       */
+      GFDM_KERNELS_API void multiply_circular_add(gfdm_complex* target, int target_len, int target_offset,
+                                          const gfdm_complex* in, const gfdm_complex* taps, int n);
+
+      /*!
+       * out[m] = sum over l < fold of in[(in_offset + l * n + m) % in_len] * taps[l * n + m]
+       * for 0 <= m < n. Filtering and superposition of one subcarrier in the receiver.
+       */
+      GFDM_KERNELS_API void gather_multiply_fold(gfdm_complex* out, const gfdm_complex* in, int in_len, int in_offset,
+                                         const gfdm_complex* taps, int n, int fold);
+
+      //! Same as above, but with the named implementation. For tests and profiling.
+      GFDM_KERNELS_API void multiply_circular_add_manual(const std::string& impl, gfdm_complex* target, int target_len,
+                                                 int target_offset, const gfdm_complex* in, const gfdm_complex* taps, int n);
+      GFDM_KERNELS_API void gather_multiply_fold_manual(const std::string& impl, gfdm_complex* out, const gfdm_complex* in,
+                                                int in_len, int in_offset, const gfdm_complex* taps, int n, int fold);
+
+      GFDM_KERNELS_API std::string kernel_name(kernel_t kernel);
+      //! Implementations built in and supported by this CPU, "generic" first.
+      GFDM_KERNELS_API std::vector<std::string> available_impls();
+      //! Throws std::invalid_argument if impl is not available.
+      GFDM_KERNELS_API void select_impl(kernel_t kernel, const std::string& impl);
+      GFDM_KERNELS_API std::string selected_impl(kernel_t kernel);
+      //! $HOME/.gfdm/simd_config, one "kernel_name impl" line per kernel.
+      GFDM_KERNELS_API std::string config_filename();
+
+    } /* namespace simd */
+  } /* namespace gfdm */
+} /* namespace gr */
+
+#endif /* INCLUDED_GFDM_SIMD_KERNELS_H */
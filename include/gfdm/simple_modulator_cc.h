@@ -47,6 +47,17 @@ namespace gr {
        * creating new instances.
        */
       static sptr make(int n_timeslots, int n_subcarriers, int overlap, std::vector<gr_complex> frequency_taps);
+
+      /*!
+       * \brief Mean time and histogram per kernel stage, see gr::gfdm::stage_timers_to_pmt().
+       *  Stages are only timed if gr-gfdm is built with ENABLE_STAGE_TIMERS, frames are
+       *  counted either way. The same dict is published on the "stage_timing" message
+       *  port every stage_timing_interval frames.
+       */
+      virtual pmt::pmt_t stage_timing() = 0;
+      virtual void reset_stage_timing() = 0;
+      //! Frames between "stage_timing" messages, 0 disables them.
+      virtual void set_stage_timing_interval(int n_frames) = 0;
     };
 
   } // namespace gfdm
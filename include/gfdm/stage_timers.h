@@ -0,0 +1,121 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2016 Andrej Rode.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef INCLUDED_GFDM_STAGE_TIMERS_H
+#define INCLUDED_GFDM_STAGE_TIMERS_H
+
+#include <gfdm/kernels_api.h>
+#include <stdint.h>
+#include <time.h>
+#include <string>
+#include <vector>
+#if defined(__i386__) || defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
+/*
+ * Stage timing hooks for kernel code. They only expand to anything if the
+ * library is configured with ENABLE_STAGE_TIMERS, otherwise not even the
+ * timestamp is taken and GFDM_STAGE_COMMIT only counts the frame.
+ */
+#ifdef GFDM_STAGE_TIMERS
+#define GFDM_STAGE_BEGIN(timers) (timers).begin()
+#define GFDM_STAGE_LAP(timers, stage) (timers).lap(stage)
+#define GFDM_STAGE_COMMIT(timers) (timers).commit()
+#else
+#define GFDM_STAGE_BEGIN(timers)
+#define GFDM_STAGE_LAP(timers, stage)
+#define GFDM_STAGE_COMMIT(timers) (timers).count_frame()
+#endif
+
+namespace gr {
+  namespace gfdm {
+
+    /*!
+     * \brief Per-instance histograms of the time spent in each stage of a kernel.
+     *  begin() starts a frame, lap(stage) charges the time since the previous
+     *  timestamp to stage, commit() ends the frame and adds each stage's share
+     *  to its histogram. Histogram buckets are powers of two of TSC ticks.
+     *
+     *  Kernels are driven from a single thread. Reading from another thread
+     *  while frames are committed gives a snapshot that may be off by a frame.
+     */
+    class GFDM_KERNELS_API stage_timers
+    {
+    public:
+      static const int N_BUCKETS = 48;
+
+      stage_timers(const char* const* stage_names, int n_stages);
+
+      //! true if the library was built with ENABLE_STAGE_TIMERS.
+      static bool compiled_in();
+      //! TSC on x86, monotonic_ns() elsewhere.
+      static uint64_t now()
+      {
+#if defined(__i386__) || defined(__x86_64__)
+        return __rdtsc();
+#else
+        return monotonic_ns();
+#endif
+      };
+      //! CLOCK_MONOTONIC in nanoseconds.
+      static uint64_t monotonic_ns()
+      {
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return uint64_t(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+      };
+      //! now() ticks per nanosecond, calibrated once against monotonic_ns().
+      static double ticks_per_ns();
+
+      void begin(){ d_last = now();};
+      void lap(int stage)
+      {
+        const uint64_t t = now();
+        d_frame_ticks[stage] += t - d_last;
+        d_last = t;
+      };
+      void commit();
+      //! commit() without timestamps, frames are counted either way.
+      void count_frame(){ d_n_frames++;};
+      void reset();
+
+      int n_stages() const { return d_names.size();};
+      const std::string& stage_name(int stage) const { return d_names[stage];};
+      uint64_t n_frames() const { return d_n_frames;};
+      double mean_ns(int stage) const;
+      //! Frame count per bucket, bucket b holds frames with [2^b, 2^(b+1)) ticks in stage.
+      std::vector<uint64_t> histogram(int stage) const;
+
+    private:
+      std::vector<std::string> d_names;
+      uint64_t d_last;
+      uint64_t d_n_frames;
+      std::vector<uint64_t> d_frame_ticks;
+      std::vector<uint64_t> d_total_ticks;
+      std::vector<uint64_t> d_histogram;
+    };
+
+  } // namespace gfdm
+} // namespace gr
+
+#endif /* INCLUDED_GFDM_STAGE_TIMERS_H */
+
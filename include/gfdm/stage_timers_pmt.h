@@ -0,0 +1,41 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2016 Andrej Rode.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_GFDM_STAGE_TIMERS_PMT_H
+#define INCLUDED_GFDM_STAGE_TIMERS_PMT_H
+
+#include <gfdm/api.h>
+#include <gfdm/stage_timers.h>
+#include <pmt/pmt.h>
+
+namespace gr {
+  namespace gfdm {
+
+    /*!
+     * \brief Snapshot of timers for the stage_timing message ports.
+     *  Dict with "frames" -> uint64, "ticks_per_ns" -> double and for every
+     *  stage name a dict with "mean_ns" -> double and "histogram" -> u64vector.
+     */
+    GFDM_API pmt::pmt_t stage_timers_to_pmt(const stage_timers& timers);
+
+  } // namespace gfdm
+} // namespace gr
+
+#endif /* INCLUDED_GFDM_STAGE_TIMERS_PMT_H */
@@ -30,9 +30,43 @@ namespace gr {
   namespace gfdm {
 
     /*!
-     * \brief <+description of block+>
+     * \brief Detect GFDM frames by their Schmidl & Cox preamble and tag frame starts.
      * \ingroup gfdm
      *
+     * The block searches in two stages: the CP-integrated autocorrelation
+     * metric |P|/R (Schmidl & Cox) selects candidate lags where it exceeds
+     * autocorr_threshold, then the preamble cross-correlation is evaluated
+     * only within +-search_window lags of each candidate. A frame is detected
+     * if the normalized cross-correlation peak is at least lock_threshold. Once locked it only evaluates +-track_window lags around
+     * the expected next preamble and falls back to search after
+     * max_missed_frames consecutive misses. Lock changes are tagged with
+     * "gfdm_sync_lock" (PMT_T/PMT_F).
+     *
+     * With energy_threshold_db > 0 search mode is gated by the sliding energy
+     * over one preamble length: blocks whose peak energy stays below the noise
+     * floor plus energy_threshold_db skip the correlation pipeline. The noise
+     * floor is a moving average over idle blocks; busy blocks without a
+     * detected frame can only lower it.
+     *
+     * Every detected frame is also published on the "sync" message port as a
+     * dict with the same values as its tags:
+     *  - offset: absolute input item of the preamble start (uint64)
+     *  - cfo: carrier frequency offset in preamble subcarrier spacings
+     *  - metric: normalized cross-correlation peak (0..1)
+     *  - timing_offset: peak lag minus reference lag. While searching the
+     *    reference is the autocorrelation candidate, while tracking it is the
+     *    expected position one frame after the previous preamble.
+     *  - snr_db: from the preamble autocorrelation, |P|/(R-|P|)
+     * The stream outputs are optional, with none connected the block only
+     * annotates and copies no samples. After every call a dict
+     * {processed: absolute input items searched} follows, so
+     * frame_receiver_cc with sync_messages can read the samples from the
+     * same source without a copy through sync_cc.
+     *
+     * Next to the frame tag each frame carries the "gfdm_cfo",
+     * "gfdm_timing_offset", "gfdm_sync_metric" and "gfdm_snr_db" tags with
+     * the values above. Frame and lock events are counted and can be read at
+     * runtime.
      */
     class GFDM_API sync_cc : virtual public gr::block
     {
@@ -47,7 +81,48 @@ namespace gr {
        * class. gfdm::sync_cc::make is the public interface for
        * creating new instances.
        */
-      static sptr make(int sync_fft_len, int cp_length, int fft_len, gr::gfdm::preamble_generator_sptr preamble_generator, const std::string& gfdm_tag_key = "gfdm_block" );
+      static sptr make(int sync_fft_len, int cp_length, int fft_len, gr::gfdm::preamble_generator_sptr preamble_generator, const std::string& gfdm_tag_key = "gfdm_block", float lock_threshold = 0.6, int track_window = 8, float autocorr_threshold = 0.5, int search_window = 16, float energy_threshold_db = 0.0);
+
+      //! Minimum normalized cross-correlation peak (0..1) to accept a frame.
+      virtual void set_lock_threshold(float lock_threshold) = 0;
+      virtual float lock_threshold() const = 0;
+      //! Lags evaluated around the expected preamble position while locked.
+      virtual void set_track_window(int track_window) = 0;
+      virtual int track_window() const = 0;
+      //! Consecutive missed frames before falling back to search.
+      virtual void set_max_missed_frames(int max_missed_frames) = 0;
+      virtual int max_missed_frames() const = 0;
+      //! Minimum Schmidl & Cox metric |P|/R (0..1) for a candidate lag in search mode.
+      virtual void set_autocorr_threshold(float autocorr_threshold) = 0;
+      virtual float autocorr_threshold() const = 0;
+      //! Lags cross-correlated around each search candidate.
+      virtual void set_search_window(int search_window) = 0;
+      virtual int search_window() const = 0;
+      //! Energy gate threshold above the noise floor in dB, 0 disables the gate.
+      virtual void set_energy_threshold_db(float energy_threshold_db) = 0;
+      virtual float energy_threshold_db() const = 0;
+      //! Current noise floor estimate (mean power per sample).
+      virtual float noise_floor() const = 0;
+      virtual bool locked() const = 0;
+
+      //! Metrics of the last evaluated frame candidate.
+      virtual float frame_autocorr_metric() const = 0;
+      virtual float frame_xcorr_metric() const = 0;
+      //! CFO of the last evaluated frame candidate in preamble subcarrier spacings.
+      virtual float frame_cfo() const = 0;
+      virtual float frame_snr_db() const = 0;
+      //! Cross-correlation peak lag minus autocorrelation candidate (search) or expected position (track).
+      virtual int frame_timing_offset() const = 0;
+
+      //! Event counters, safe to read from any thread.
+      virtual uint64_t frames_detected() const = 0;
+      virtual uint64_t frames_missed() const = 0;
+      virtual uint64_t locks_acquired() const = 0;
+      virtual uint64_t locks_lost() const = 0;
+      virtual uint64_t idle_blocks() const = 0;
+      //! Work counters: autocorrelation lags and preamble cross-correlation lags evaluated.
+      virtual uint64_t autocorr_lags() const = 0;
+      virtual uint64_t xcorr_lags() const = 0;
     };
 
   } // namespace gfdm
@@ -0,0 +1,84 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2016 Andrej Rode.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef INCLUDED_GFDM_SYNC_KERNEL_CC_H
+#define INCLUDED_GFDM_SYNC_KERNEL_CC_H
+
+#include <gfdm/kernels_api.h>
+#include <gfdm/preamble_generator.h>
+#include <gfdm/preamble_correlator_cc.h>
+#include <complex>
+#include <vector>
+#include <boost/shared_ptr.hpp>
+
+namespace gr {
+  namespace gfdm {
+
+    /*!
+     * \brief Correlation stages of the Schmidl & Cox preamble detector in sync_cc.
+     *  The preamble consists of two identical halves of length L = preamble_len / 2.
+     *
+     */
+    class GFDM_KERNELS_API sync_kernel_cc
+    {
+    public:
+      typedef std::complex<float> gfdm_complex;
+      typedef boost::shared_ptr<sync_kernel_cc> sptr;
+
+      /*!
+       * \param max_lags most lags correlate_window() is expected to compute per call, sizes the overlap-save FFT.
+       */
+      sync_kernel_cc(preamble_generator_sptr preamble_generator, int max_lags);
+      ~sync_kernel_cc();
+
+      /*!
+       * p_out[i] = 1/L * sum_{n<L} conj(p_in[i + n]) * p_in[i + n + L]
+       * Reads num_items + 2 * L - 1 items from p_in.
+       */
+      void autocorrelate(gfdm_complex* p_out, const gfdm_complex* p_in, int num_items);
+      /*!
+       * p_out[i] = 1/preamble_len * sum_k conj(preamble[k]) * p_in[i + k]
+       * Direct dot products for short windows, overlap-save for long ones.
+       * Reads n_lags + preamble_len - 1 items from p_in.
+       */
+      void correlate_window(gfdm_complex* p_out, const gfdm_complex* p_in, int n_lags);
+      //! Schmidl & Cox metric |P|/R at p_in, cfo = angle(P)/pi in preamble subcarrier spacings.
+      float autocorr_metric(const gfdm_complex* p_in, float& cfo);
+      //! |cc| of correlate_window() at p_in normalized by preamble and input energy (0..1).
+      float normalized_metric(const gfdm_complex& cc, const gfdm_complex* p_in);
+      int preamble_len(){ return d_preamble_len;};
+    private:
+      int d_preamble_len;
+      int d_L;
+      int d_autocorr_block_len;
+      int d_direct_max_lags;
+      std::vector<gfdm_complex> d_preamble;
+      float d_preamble_energy;
+      preamble_correlator_cc::sptr d_correlator;
+      std::vector<gfdm_complex> d_autocorr_products;
+      std::vector<gfdm_complex> d_autocorr_diff;
+      std::vector<gfdm_complex> d_autocorr_carry;
+    };
+
+  } // namespace gfdm
+} // namespace gr
+
+#endif /* INCLUDED_GFDM_SYNC_KERNEL_CC_H */
@@ -0,0 +1,95 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2016 Andrej Rode.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef INCLUDED_GFDM_TRACER_H
+#define INCLUDED_GFDM_TRACER_H
+
+#include <gfdm/kernels_api.h>
+#include <boost/atomic.hpp>
+#include <stdint.h>
+#include <string>
+
+namespace gr {
+  namespace gfdm {
+
+    /*!
+     * \brief Process-wide execution tracer writing Chrome trace-event JSON.
+     *  Every thread records spans into its own ring buffer, recording is
+     *  wait-free and the oldest events are overwritten once a ring is full.
+     *  dump() may run concurrently with recording and skips events that were
+     *  overwritten while it copied. It never reads the slot that is written
+     *  next, so it returns at most events_per_thread - 1 events per thread.
+     *
+     *  Tracing is off by default. It is switched on by enable() or by setting
+     *  GFDM_TRACE=<file.json> in the environment, in the latter case the trace
+     *  is written to that file at process exit. Load it in chrome://tracing or
+     *  ui.perfetto.dev.
+     */
+    class GFDM_KERNELS_API tracer
+    {
+    public:
+      //! Start recording, events_per_thread is rounded up to a power of two.
+      static void enable(int events_per_thread = 1 << 16);
+      static void disable();
+      static bool enabled(){ return s_enabled.load(boost::memory_order_relaxed);};
+
+      //! Write all buffered events as {"traceEvents": [...]}, returns false if the file can't be opened.
+      static bool dump(const std::string& filename);
+      //! Drop all buffered events.
+      static void clear();
+
+      //! Microseconds on the trace clock.
+      static double now_us();
+      //! Record a complete span. name must outlive the tracer, i.e. be a string literal.
+      static void record(const char* name, double start_us, double end_us, int64_t frames);
+
+    private:
+      static boost::atomic<bool> s_enabled;
+    };
+
+    /*!
+     * \brief Records the lifetime of the object as one span on the calling thread.
+     *  Costs a relaxed atomic load if tracing is disabled.
+     */
+    class trace_span
+    {
+    public:
+      explicit trace_span(const char* name)
+        : d_name(name), d_start_us(tracer::enabled() ? tracer::now_us() : -1.0), d_frames(-1) {};
+      ~trace_span()
+      {
+        if(d_start_us >= 0.0){
+          tracer::record(d_name, d_start_us, tracer::now_us(), d_frames);
+        }
+      };
+      //! Attach the number of frames processed in this span as argument.
+      void set_frames(int64_t frames){ d_frames = frames;};
+    private:
+      const char* d_name;
+      double d_start_us;
+      int64_t d_frames;
+    };
+
+  } // namespace gfdm
+} // namespace gr
+
+#endif /* INCLUDED_GFDM_TRACER_H */
+
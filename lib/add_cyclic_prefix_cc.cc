@@ -21,42 +21,77 @@
 #include <gfdm/add_cyclic_prefix_cc.h>
 #include <volk/volk.h>
 #include <iostream>
+#include <algorithm>
+#include <stdexcept>
 #include <string.h>
 
 namespace gr {
   namespace gfdm {
 
-    add_cyclic_prefix_cc::add_cyclic_prefix_cc(int ramp_len, int cp_len, int block_len, std::vector<gfdm_complex> window_taps)
-            : d_ramp_len(ramp_len), d_cp_len(cp_len), d_block_len(block_len)
+    add_cyclic_prefix_cc::add_cyclic_prefix_cc(int ramp_len, int cp_len, int block_len, std::vector<gfdm_complex> window_taps, bool cyclic_suffix)
+            : d_ramp_len(ramp_len), d_cp_len(cp_len), d_block_len(block_len), d_cyclic_suffix(cyclic_suffix)
     {
-      int window_len = block_len + cp_len;
+      // the window spans the cyclic suffix as well if there is one.
+      int window_len = block_len + cp_len + (cyclic_suffix ? ramp_len : 0);
       if(window_taps.size() != window_len && window_taps.size() != 2 * ramp_len){
-        throw std::invalid_argument("ERROR: number of window_taps elements MUST be equal to 2*ramp_len OR n_timeslots*n_subcarriers+cp_len!");
+        throw std::invalid_argument("ERROR: number of window_taps elements MUST be equal to 2*ramp_len OR n_timeslots*n_subcarriers+cp_len(+ramp_len with cyclic suffix)!");
+      }
+      if(cyclic_suffix && ramp_len > block_len){
+        throw std::invalid_argument("ERROR: ramp_len MUST NOT exceed block_len with cyclic suffix!");
       }
 
       d_front_ramp = (gfdm_complex*) volk_malloc(sizeof(gfdm_complex) * ramp_len, volk_get_alignment());
       d_back_ramp = (gfdm_complex*) volk_malloc(sizeof(gfdm_complex) * ramp_len, volk_get_alignment());
       memcpy(d_front_ramp, &window_taps[0], sizeof(gfdm_complex) * ramp_len);
-      memcpy(d_back_ramp, &window_taps[block_len + cp_len - ramp_len], sizeof(gfdm_complex) * ramp_len);
+      memcpy(d_back_ramp, &window_taps[window_taps.size() - ramp_len], sizeof(gfdm_complex) * ramp_len);
+
+      d_overlap = (gfdm_complex*) volk_malloc(sizeof(gfdm_complex) * ramp_len, volk_get_alignment());
+      d_suffix = (gfdm_complex*) volk_malloc(sizeof(gfdm_complex) * ramp_len, volk_get_alignment());
+      reset_overlap();
     }
 
     add_cyclic_prefix_cc::~add_cyclic_prefix_cc()
     {
       volk_free(d_front_ramp);
       volk_free(d_back_ramp);
+      volk_free(d_overlap);
+      volk_free(d_suffix);
+    }
+
+    void
+    add_cyclic_prefix_cc::reset_overlap()
+    {
+      memset(d_overlap, 0x00, sizeof(gfdm_complex) * d_ramp_len);
     }
 
     void
     add_cyclic_prefix_cc::generic_work(gfdm_complex* p_out, const gfdm_complex* p_in)
     {
-      const int cp_start = block_size() - d_cp_len;
-      memcpy(p_out, p_in + cp_start, sizeof(gfdm_complex) * d_cp_len);
       memcpy(p_out + d_cp_len, p_in, sizeof(gfdm_complex) * block_size());
+      add_cyclic_prefix_in_place(p_out);
+    }
 
-      if(d_ramp_len > 0){
+    void
+    add_cyclic_prefix_cc::add_cyclic_prefix_in_place(gfdm_complex* p_frame)
+    {
+      const int cp_start = block_size() - d_cp_len;
+      memcpy(p_frame, p_frame + d_cp_len + cp_start, sizeof(gfdm_complex) * d_cp_len);
+
+      if(d_ramp_len == 0){
+        return;
+      }
+      if(d_cyclic_suffix){
+        // suffix = first ramp_len block samples, ramped down. It is not emitted with this frame
+        // but added onto the ramped up prefix of the next one.
+        volk_32fc_x2_multiply_32fc(d_suffix, p_frame + d_cp_len, d_back_ramp, d_ramp_len);
+        volk_32fc_x2_multiply_32fc(p_frame, p_frame, d_front_ramp, d_ramp_len);
+        volk_32f_x2_add_32f((float*) p_frame, (const float*) p_frame, (const float*) d_overlap, 2 * d_ramp_len);
+        std::swap(d_overlap, d_suffix);
+      }
+      else{
         const int tail_start = block_size() + d_cp_len - d_ramp_len;
-        volk_32fc_x2_multiply_32fc(p_out, p_out, d_front_ramp, d_ramp_len);
-        volk_32fc_x2_multiply_32fc(p_out + tail_start, p_out + tail_start, d_back_ramp, d_ramp_len);
+        volk_32fc_x2_multiply_32fc(p_frame, p_frame, d_front_ramp, d_ramp_len);
+        volk_32fc_x2_multiply_32fc(p_frame + tail_start, p_frame + tail_start, d_back_ramp, d_ramp_len);
       }
     }
 
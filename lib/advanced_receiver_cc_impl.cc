@@ -24,6 +24,8 @@
 
 #include <gnuradio/io_signature.h>
 #include "advanced_receiver_cc_impl.h"
+#include <gfdm/tracer.h>
+#include <gfdm/stage_timers_pmt.h>
 
 namespace gr {
   namespace gfdm {
@@ -45,15 +47,14 @@ namespace gr {
               len_tag_key),
       gfdm_receiver(nsubcarrier, ntimeslots, filter_alpha, fft_len),
       d_constellation(constellation),
-      d_ic_iter(ic_iter)
+      d_constellation_points(constellation ? constellation->points() : std::vector<gr_complex>()),
+      d_ic_iter(ic_iter),
+      d_stage_timing_interval(1000), d_frames_since_timing(0)
     {
       set_relative_rate(double(d_N)/double(d_fft_len));
-      d_ic_filter_taps.resize(d_ntimeslots);
-      // Only works for d_filter_width = 2
-      ::volk_32fc_x2_multiply_32fc(&d_ic_filter_taps[0],&d_filter_taps[0],&d_filter_taps[d_ntimeslots],d_ntimeslots);
-      d_sc_fft = new fft::fft_complex(d_ntimeslots,true,1);
-      d_sc_fft_in = d_sc_fft->get_inbuf();
-      d_sc_fft_out = d_sc_fft->get_outbuf();
+
+      d_stage_timing_port = pmt::mp("stage_timing");
+      message_port_register_out(d_stage_timing_port);
     }
 
     /*
@@ -63,6 +64,27 @@ namespace gr {
     {
     }
 
+    pmt::pmt_t
+    advanced_receiver_cc_impl::stage_timing()
+    {
+      gr::thread::scoped_lock guard(d_setlock);
+      return stage_timers_to_pmt(d_timers);
+    }
+
+    void
+    advanced_receiver_cc_impl::reset_stage_timing()
+    {
+      gr::thread::scoped_lock guard(d_setlock);
+      d_timers.reset();
+    }
+
+    void
+    advanced_receiver_cc_impl::set_stage_timing_interval(int n_frames)
+    {
+      gr::thread::scoped_lock guard(d_setlock);
+      d_stage_timing_interval = n_frames;
+    }
+
     int
     advanced_receiver_cc_impl::calculate_output_stream_length(const gr_vector_int &ninput_items)
     {
@@ -79,61 +101,19 @@ namespace gr {
       const gr_complex *in = (const gr_complex *) input_items[0];
       gr_complex *out = (gr_complex *) output_items[0];
 
-      filter_superposition(d_sc_fdomain,&in[0]);
-      demodulate_subcarrier(d_sc_symbols,d_sc_fdomain);
-      for (int j=0;j<d_ic_iter;j++)
-      {
-        map_sc_symbols(d_sc_symbols);
-        remove_sc_interference(d_sc_symbols,d_sc_fdomain);
-        //Should work since output is assigned after operation and no volk calls are in demodulate_subcarrier
-        demodulate_subcarrier(d_sc_symbols,d_sc_symbols);
-      }
-      serialize_output(&out[0],d_sc_symbols);
-
-      return d_N;
-    }
-
-    void
-    advanced_receiver_cc_impl::map_sc_symbols( std::vector< std::vector<gr_complex> > &sc_symbols)
-    {
-      unsigned int symbol_tmp = 0;
-      std::vector<gr_complex> const_points = d_constellation->points();
-      for (int k=0;k<d_nsubcarrier;k++)
-      {
-        for (int m=0;m<d_ntimeslots;m++)
-        {
-          symbol_tmp =d_constellation->decision_maker(&sc_symbols[k][m]);
-          sc_symbols[k][m] = const_points[symbol_tmp];
-        }
-      }
-    }
-
-    void
-    advanced_receiver_cc_impl::remove_sc_interference(std::vector< std::vector<gr_complex> > &sc_symbols, std::vector< std::vector<gr_complex> > &sc_fdomain)
-    {
-      std::vector< std::vector<gr_complex> > prev_sc_symbols = sc_symbols;
-      std::vector<gr_complex> sc_tmp(d_ntimeslots);
-      std::vector<gr_complex> sc_zeros(d_ntimeslots);
-      for (int k=0; k<d_nsubcarrier; k++)
-      {
-        if(d_ntimeslots*d_nsubcarrier < d_N && ((k==0) || (k==d_nsubcarrier-1)))
-        {
-          if (k==0)
-          {
-            ::volk_32f_x2_add_32f((float*)&d_sc_fft_in[0],(float*)&prev_sc_symbols[((k+1)% d_nsubcarrier)][0],(float*)&sc_zeros[0],2*d_ntimeslots);
-          }else if(k==d_nsubcarrier-1){
-            ::volk_32f_x2_add_32f((float*)&d_sc_fft_in[0],(float*)&prev_sc_symbols[(((k-1) % d_nsubcarrier) + d_nsubcarrier ) % d_nsubcarrier][0],(float*)&sc_zeros[0],2*d_ntimeslots);
-          }
-        }else{
-          ::volk_32f_x2_add_32f((float*)&d_sc_fft_in[0],(float*)&prev_sc_symbols[(((k-1) % d_nsubcarrier) + d_nsubcarrier) % d_nsubcarrier][0],(float*)&prev_sc_symbols[((k+1)% d_nsubcarrier)][0],2*d_ntimeslots);
-        }
-        d_sc_fft->execute();
-        ::volk_32fc_x2_multiply_32fc(&sc_symbols[k][0],&d_ic_filter_taps[0],&d_sc_fft_out[0],d_ntimeslots);
-        ::volk_32f_x2_subtract_32f((float*)&sc_tmp[0],(float*)&sc_fdomain[k][0],(float*)&sc_symbols[k][0],2*d_ntimeslots);
-        ::std::memcpy(&sc_symbols[k][0],&sc_tmp[0],sizeof(gr_complex)*d_ntimeslots);
+      trace_span span("advanced_receiver_cc::work");
+      span.set_frames(1);
+      gfdm_work_ic(&out[0],&in[0],d_ic_iter,d_constellation_points);
 
+#ifdef GFDM_STAGE_TIMERS
+      d_frames_since_timing += 1;
+      if(d_stage_timing_interval > 0 && d_frames_since_timing >= d_stage_timing_interval){
+        message_port_pub(d_stage_timing_port, stage_timers_to_pmt(d_timers));
+        d_frames_since_timing = 0;
       }
+#endif
 
+      return d_N;
     }
 
   } /* namespace gfdm */
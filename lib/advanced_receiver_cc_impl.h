@@ -30,15 +30,12 @@ namespace gr {
     {
      private:
        int d_ic_iter;
-       std::vector<gr_complex> d_ic_filter_taps;
        gr::digital::constellation_sptr d_constellation;
-       void map_sc_symbols(std::vector< std::vector<gr_complex> > &sc_symbols);
-       void remove_sc_interference(
-           std::vector< std::vector<gr_complex> > &sc_symbols,
-           std::vector< std::vector<gr_complex> > &sc_fdomain);
-       fft::fft_complex *d_sc_fft;
-       gr_complex *d_sc_fft_in;
-       gr_complex *d_sc_fft_out;
+       //! decision points of d_constellation for the SIC in gfdm_receiver
+       std::vector<gr_complex> d_constellation_points;
+       pmt::pmt_t d_stage_timing_port;
+       int d_stage_timing_interval;
+       int d_frames_since_timing;
      protected:
       int calculate_output_stream_length(const gr_vector_int &ninput_items);
 
@@ -53,6 +50,9 @@ namespace gr {
           const std::string& len_tag_key);
       ~advanced_receiver_cc_impl();
       void set_ic(int ic_iter){d_ic_iter = ic_iter;}
+      pmt::pmt_t stage_timing();
+      void reset_stage_timing();
+      void set_stage_timing_interval(int n_frames);
 
       // Where all the action really happens
       int work(int noutput_items,
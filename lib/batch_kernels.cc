@@ -0,0 +1,163 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2016 Andrej Rode.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gfdm/batch_kernels.h>
+#include <gfdm/tracer.h>
+#include <boost/bind.hpp>
+#include <boost/function.hpp>
+#include <boost/thread/thread.hpp>
+#include <algorithm>
+#include <stdexcept>
+
+namespace gr {
+  namespace gfdm {
+
+    namespace {
+      typedef boost::function<void (int, int, int)> chunk_fn;
+
+      // chunk(t, first, last) for up to nthreads contiguous frame ranges,
+      // the first range runs on the calling thread.
+      void
+      for_each_chunk(int nthreads, int n_frames, const chunk_fn& chunk)
+      {
+        const int n_chunks = std::min(nthreads, n_frames);
+        boost::thread_group workers;
+        for(int t = 1; t < n_chunks; t++){
+          workers.create_thread(boost::bind(chunk, t, int(long(n_frames) * t / n_chunks),
+                                            int(long(n_frames) * (t + 1) / n_chunks)));
+        }
+        if(n_chunks > 0){
+          chunk(0, 0, n_frames / n_chunks);
+        }
+        workers.join_all();
+      }
+
+      void
+      check_args(int n_frames, int nthreads)
+      {
+        if(n_frames < 0){
+          throw std::invalid_argument("n_frames MUST NOT be negative");
+        }
+        if(nthreads < 1){
+          throw std::invalid_argument("nthreads MUST be at least 1");
+        }
+      }
+    }
+
+    batch_modulator::batch_modulator(int n_timeslots, int n_subcarriers, int overlap,
+                                     std::vector<gfdm_complex> frequency_taps, int nthreads)
+      : d_block_size(n_timeslots * n_subcarriers)
+    {
+      check_args(0, nthreads);
+      for(int t = 0; t < nthreads; t++){
+        d_kernels.push_back(boost::shared_ptr<modulator_kernel_cc>(
+            new modulator_kernel_cc(n_timeslots, n_subcarriers, overlap, frequency_taps)));
+      }
+    }
+
+    void
+    batch_modulator::modulate(gfdm_complex* out, const gfdm_complex* in, int n_frames)
+    {
+      check_args(n_frames, nthreads());
+      trace_span span("batch_modulator::modulate");
+      span.set_frames(n_frames);
+      for_each_chunk(nthreads(), n_frames,
+                     boost::bind(&batch_modulator::run_chunk, this, _1, out, in, _2, _3));
+    }
+
+    void
+    batch_modulator::run_chunk(int kernel, gfdm_complex* out, const gfdm_complex* in, int first, int last)
+    {
+      // generic_work reads the whole frame before it writes, so in-place is fine.
+      modulator_kernel_cc& k = *d_kernels[kernel];
+      for(int f = first; f < last; f++){
+        k.generic_work(out + long(f) * d_block_size, in + long(f) * d_block_size);
+      }
+    }
+
+    batch_receiver::batch_receiver(int n_subcarriers, int n_timeslots, double filter_alpha, int fft_len, int nthreads)
+      : d_fft_len(fft_len), d_block_size(n_subcarriers * n_timeslots)
+    {
+      check_args(0, nthreads);
+      if(fft_len < d_block_size){
+        throw std::invalid_argument("fft_len MUST be at least n_subcarriers * n_timeslots");
+      }
+      for(int t = 0; t < nthreads; t++){
+        d_kernels.push_back(boost::shared_ptr<kernel::gfdm_receiver>(
+            new kernel::gfdm_receiver(n_subcarriers, n_timeslots, filter_alpha, fft_len)));
+      }
+    }
+
+    void
+    batch_receiver::demodulate(gfdm_complex* out, const gfdm_complex* in, int n_frames)
+    {
+      run(out, in, n_frames, 0, 0);
+    }
+
+    void
+    batch_receiver::demodulate_ic(gfdm_complex* out, const gfdm_complex* in, int n_frames, int ic_iter,
+                                  const std::vector<gfdm_complex>& constellation_points)
+    {
+      if(ic_iter > 0 && constellation_points.empty()){
+        throw std::invalid_argument("SIC needs at least one constellation point");
+      }
+      run(out, in, n_frames, ic_iter, &constellation_points);
+    }
+
+    void
+    batch_receiver::run(gfdm_complex* out, const gfdm_complex* in, int n_frames, int ic_iter,
+                        const std::vector<gfdm_complex>* constellation_points)
+    {
+      check_args(n_frames, nthreads());
+      // chunks write their output over the input of the chunk before them otherwise.
+      if(out == in && d_fft_len != d_block_size){
+        throw std::invalid_argument("in-place demodulation needs fft_len == n_subcarriers * n_timeslots");
+      }
+      trace_span span("batch_receiver::demodulate");
+      span.set_frames(n_frames);
+      for_each_chunk(nthreads(), n_frames,
+                     boost::bind(&batch_receiver::run_chunk, this, _1, out, in, _2, _3,
+                                 ic_iter, constellation_points));
+    }
+
+    void
+    batch_receiver::run_chunk(int kernel, gfdm_complex* out, const gfdm_complex* in, int first, int last,
+                              int ic_iter, const std::vector<gfdm_complex>* constellation_points)
+    {
+      // the receiver copies its input into the FFT buffer first, so in-place is fine.
+      kernel::gfdm_receiver& k = *d_kernels[kernel];
+      for(int f = first; f < last; f++){
+        gfdm_complex* frame_out = out + long(f) * d_block_size;
+        const gfdm_complex* frame_in = in + long(f) * d_fft_len;
+        if(ic_iter > 0){
+          k.gfdm_work_ic(frame_out, frame_in, ic_iter, *constellation_points);
+        }
+        else{
+          k.gfdm_work(frame_out, frame_in, d_fft_len, d_block_size);
+        }
+      }
+    }
+
+  } /* namespace gfdm */
+} /* namespace gr */
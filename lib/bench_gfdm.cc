@@ -0,0 +1,158 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2016 Andrej Rode.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Micro-benchmark for the GFDM signal processing kernels.
+ *
+ * Every kernel is timed for one frame per call over a grid of
+ * (K subcarriers, M timeslots, L overlap, receiver fft_len, sync fft_len).
+ * Results go to stdout as JSON, one object per (kernel, parameter set).
+ *
+ * usage: bench-gfdm [options] [min_seconds_per_case], see --help
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "kernel_bench.h"
+#include <boost/program_options.hpp>
+#include <boost/algorithm/string.hpp>
+#include <boost/lexical_cast.hpp>
+#include <iostream>
+#include <stdexcept>
+
+namespace po = boost::program_options;
+
+namespace gr {
+  namespace gfdm {
+    namespace bench {
+
+      static std::vector<int>
+      parse_int_list(const std::string& s)
+      {
+        std::vector<std::string> fields;
+        boost::split(fields, s, boost::is_any_of(","));
+        std::vector<int> values;
+        for(size_t i = 0; i < fields.size(); i++){
+          values.push_back(boost::lexical_cast<int>(boost::trim_copy(fields[i])));
+        }
+        return values;
+      }
+
+      static void
+      report(std::ostream& os, bool& first, const named_case_t& n, double min_seconds)
+      {
+        const params_t& p = n.params;
+        bench_case& c = *n.bench;
+        long n_runs;
+        const double ns = time_case(c, min_seconds, n_runs);
+        os << (first ? "\n" : ",\n");
+        first = false;
+        os << "    {\"kernel\": \"" << n.kernel << "\", \"K\": " << p.K << ", \"M\": " << p.M
+           << ", \"L\": " << p.L << ", \"fft_len\": " << p.fft_len
+           << ", \"items_per_frame\": " << c.items() << ", \"runs\": " << n_runs
+           << ", \"ns_per_frame\": " << ns << ", \"msps\": " << 1e3 * c.items() / ns << "}";
+        os.flush();
+      }
+
+    } /* namespace bench */
+  } /* namespace gfdm */
+} /* namespace gr */
+
+int
+main(int argc, char **argv)
+{
+  using namespace gr::gfdm::bench;
+  std::string K_list;
+  std::string M_list;
+  std::string L_list;
+  std::string fft_len_list;
+  std::string sync_list;
+  double min_seconds;
+
+  po::options_description desc("bench-gfdm [options] [min-seconds]");
+  desc.add_options()
+    ("help,h", "show this help")
+    ("subcarriers,K", po::value<std::string>(&K_list)->default_value("16,64,128"), "comma separated subcarrier counts")
+    ("timeslots,M", po::value<std::string>(&M_list)->default_value("5,15"), "comma separated timeslot counts")
+    ("overlap,L", po::value<std::string>(&L_list)->default_value("2"), "filter overlap, only 2 is supported")
+    ("fft-len", po::value<std::string>(&fft_len_list)->default_value("0"),
+     "comma separated receiver fft lengths, 0 for K*M")
+    ("sync-factors", po::value<std::string>(&sync_list)->default_value("2,4"),
+     "comma separated sync fft lengths in multiples of K, the preamble spans two subcarrier symbols")
+    ("min-seconds", po::value<double>(&min_seconds)->default_value(0.2), "time per case");
+  po::positional_options_description positional;
+  positional.add("min-seconds", 1);
+
+  try{
+    po::variables_map vm;
+    po::store(po::command_line_parser(argc, argv).options(desc).positional(positional).run(), vm);
+    po::notify(vm);
+    if(vm.count("help")){
+      std::cout << desc << std::endl;
+      return 0;
+    }
+
+    const std::vector<int> Ks = parse_int_list(K_list);
+    const std::vector<int> Ms = parse_int_list(M_list);
+    const std::vector<int> Ls = parse_int_list(L_list);
+    for(size_t il = 0; il < Ls.size(); il++){
+      if(Ls[il] != 2){
+        throw std::invalid_argument("--overlap MUST be 2, rrc_filter_sparse only designs L=2 filters");
+      }
+    }
+    const std::vector<int> fft_lens = parse_int_list(fft_len_list);
+    const std::vector<int> sync_factors = parse_int_list(sync_list);
+
+    std::srand(42);
+    std::ostream& os = std::cout;
+    os.precision(6);
+    os << "{\n  \"benchmark\": \"gfdm\",\n  \"min_seconds\": " << min_seconds << ",\n  \"results\": [";
+    bool first = true;
+
+    for(size_t ik = 0; ik < Ks.size(); ik++){
+      for(size_t im = 0; im < Ms.size(); im++){
+        for(size_t il = 0; il < Ls.size(); il++){
+          for(size_t in = 0; in < fft_lens.size(); in++){
+            params_t p = {Ks[ik], Ms[im], Ls[il], fft_lens[in] > 0 ? fft_lens[in] : Ks[ik] * Ms[im]};
+            if(p.fft_len < p.K * p.M){
+              throw std::invalid_argument("--fft-len MUST be at least K*M");
+            }
+            std::vector<int> sync_fft_lens;
+            for(size_t is = 0; is < sync_factors.size(); is++){
+              sync_fft_lens.push_back(sync_factors[is] * p.K);
+            }
+            std::vector<named_case_t> cases = make_cases(p, sync_fft_lens);
+            for(size_t i = 0; i < cases.size(); i++){
+              report(os, first, cases[i], min_seconds);
+            }
+          }
+        }
+      }
+    }
+    os << "\n  ]\n}\n";
+  }
+  catch(std::exception& e){
+    std::cerr << "bench-gfdm: " << e.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
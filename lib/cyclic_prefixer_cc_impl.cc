@@ -29,17 +29,17 @@ namespace gr {
   namespace gfdm {
 
     cyclic_prefixer_cc::sptr
-    cyclic_prefixer_cc::make(int cp_length, int ramp_len, int block_len, std::vector<gr_complex> window_taps)
+    cyclic_prefixer_cc::make(int cp_length, int ramp_len, int block_len, std::vector<gr_complex> window_taps, bool cyclic_suffix)
     {
       return gnuradio::get_initial_sptr
-              (new cyclic_prefixer_cc_impl(ramp_len, cp_length, block_len, window_taps));
+              (new cyclic_prefixer_cc_impl(ramp_len, cp_length, block_len, window_taps, cyclic_suffix));
     }
 
     /*
      * The private constructor
      */
     cyclic_prefixer_cc_impl::cyclic_prefixer_cc_impl(int ramp_len, int cp_length, int block_len,
-                                                     std::vector<gr_complex> window_taps)
+                                                     std::vector<gr_complex> window_taps, bool cyclic_suffix)
             : gr::block("cyclic_prefixer_cc",
                                       gr::io_signature::make(1, 1, sizeof(gr_complex)),
                                       gr::io_signature::make(1, 1, sizeof(gr_complex))),
@@ -47,7 +47,7 @@ namespace gr {
     {
       // all the work is done in the kernel!
       d_kernel = add_cyclic_prefix_cc::sptr(
-              new add_cyclic_prefix_cc(ramp_len, cp_length, block_len, window_taps));
+              new add_cyclic_prefix_cc(ramp_len, cp_length, block_len, window_taps, cyclic_suffix));
 
       // set block properties!
       set_relative_rate(1.0 * d_kernel->frame_size() / d_kernel->block_size());
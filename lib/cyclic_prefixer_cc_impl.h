@@ -37,7 +37,7 @@ namespace gr
 
     public:
       cyclic_prefixer_cc_impl(int ramp_len, int cp_length, int block_len,
-                              std::vector<gr_complex> window_taps);
+                              std::vector<gr_complex> window_taps, bool cyclic_suffix);
 
       ~cyclic_prefixer_cc_impl();
 
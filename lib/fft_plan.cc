@@ -0,0 +1,379 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2016 Andrej Rode.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <gfdm/fft_plan.h>
+#include <boost/atomic.hpp>
+#include <boost/bind.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/once.hpp>
+#include <boost/thread/thread.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <stdexcept>
+#include <string>
+
+namespace gr {
+  namespace gfdm {
+
+    namespace {
+      boost::mutex* s_planner_mutex = 0;
+
+      boost::mutex&
+      planner_mutex()
+      {
+        static boost::mutex s_own_mutex;
+        return s_planner_mutex ? *s_planner_mutex : s_own_mutex;
+      }
+    }
+
+    struct fft_plan::state
+    {
+      int fft_len;
+      int nthreads;
+      bool forward;
+      bool in_place;
+      fftwf_plan initial;   // FFTW_ESTIMATE, 0 if wisdom had a better one
+      fftwf_plan upgraded;  // written by the planner thread before current is swapped
+      boost::atomic<fftwf_plan> current;
+
+      ~state()
+      {
+        boost::mutex::scoped_lock lock(planner_mutex());
+        if(upgraded){
+          fftwf_destroy_plan(upgraded);
+        }
+        if(initial){
+          fftwf_destroy_plan(initial);
+        }
+      }
+    };
+
+    namespace {
+      // guarded by the planner mutex
+      bool s_wisdom_loaded = false;
+      unsigned s_upgrade_effort = FFTW_MEASURE;
+      int s_threads = 1;
+      int s_threads_min_len = 65536;
+      bool s_threads_initialized = false;
+
+      // Never freed: the detached planner thread may still wait on it during static destruction.
+      struct upgrade_queue
+      {
+        boost::mutex mutex;
+        boost::condition_variable cond;
+        boost::condition_variable done_cond;
+        std::deque<boost::shared_ptr<fft_plan::state> > jobs;
+        int pending;  // queued or being planned
+      };
+
+      boost::once_flag s_init_once = BOOST_ONCE_INIT;
+      upgrade_queue* s_queue = 0;
+
+      std::string
+      wisdom_filename()
+      {
+        const char* home = getenv("HOME");
+        return std::string(home ? home : ".") + "/.gr_fftw_wisdom";
+      }
+
+      // called with the planner mutex held
+      void
+      load_wisdom()
+      {
+        if(s_wisdom_loaded){
+          return;
+        }
+        s_wisdom_loaded = true;
+        FILE *fpr = fopen(wisdom_filename().c_str(), "r");
+        if(fpr != 0){
+          fftwf_import_wisdom_from_file(fpr);
+          fclose(fpr);
+        }
+      }
+
+      // called with the planner mutex held
+      void
+      save_wisdom()
+      {
+        FILE *fpw = fopen(wisdom_filename().c_str(), "w");
+        if(fpw != 0){
+          fftwf_export_wisdom_to_file(fpw);
+          fclose(fpw);
+        }
+      }
+
+      // called with the planner mutex held. Reset to 1 after planning, other FFTW users expect the default.
+      void
+      plan_with_nthreads(int nthreads)
+      {
+#ifdef FFTW3F_THREADS
+        if(!s_threads_initialized){
+          s_threads_initialized = true;
+          fftwf_init_threads();
+        }
+        fftwf_plan_with_nthreads(nthreads);
+#endif
+      }
+
+      void
+      upgrade(fft_plan::state& s)
+      {
+        // measuring clobbers the buffers, so plan on scratch ones of the same alignment.
+        fftwf_complex* in = (fftwf_complex*) fftwf_malloc(sizeof(fftwf_complex) * s.fft_len);
+        fftwf_complex* out = s.in_place ? in : (fftwf_complex*) fftwf_malloc(sizeof(fftwf_complex) * s.fft_len);
+        fftwf_plan plan;
+        {
+          boost::mutex::scoped_lock lock(planner_mutex());
+          plan_with_nthreads(s.nthreads);
+          plan = fftwf_plan_dft_1d(s.fft_len, in, out, s.forward ? FFTW_FORWARD : FFTW_BACKWARD, s_upgrade_effort);
+          plan_with_nthreads(1);
+          save_wisdom();
+        }
+        if(out != in){
+          fftwf_free(out);
+        }
+        fftwf_free(in);
+        if(plan){
+          s.upgraded = plan;
+          s.current.store(plan, boost::memory_order_release);
+        }
+      }
+
+      void
+      planner_thread()
+      {
+        for(;;){
+          boost::shared_ptr<fft_plan::state> job;
+          {
+            boost::mutex::scoped_lock lock(s_queue->mutex);
+            while(s_queue->jobs.empty()){
+              s_queue->cond.wait(lock);
+            }
+            job = s_queue->jobs.front();
+            s_queue->jobs.pop_front();
+          }
+          // nobody else holds it: the kernel is gone already.
+          if(!job.unique()){
+            upgrade(*job);
+          }
+          job.reset();
+          boost::mutex::scoped_lock lock(s_queue->mutex);
+          if(--s_queue->pending == 0){
+            s_queue->done_cond.notify_all();
+          }
+        }
+      }
+
+      // Static destruction must not start while the planner thread holds the
+      // planner mutex: drop queued upgrades and wait for the running one.
+      void
+      finish_upgrades()
+      {
+        std::deque<boost::shared_ptr<fft_plan::state> > dropped;
+        boost::mutex::scoped_lock lock(s_queue->mutex);
+        dropped.swap(s_queue->jobs);
+        s_queue->pending -= dropped.size();
+        while(s_queue->pending > 0){
+          s_queue->done_cond.wait(lock);
+        }
+      }
+
+      void
+      init()
+      {
+        const char* env = getenv("GFDM_FFTW_EFFORT");
+        if(env != 0){
+          const std::string effort(env);
+          if(effort == "estimate"){
+            s_upgrade_effort = FFTW_ESTIMATE;
+          }else if(effort == "patient"){
+            s_upgrade_effort = FFTW_PATIENT;
+          }else if(effort == "exhaustive"){
+            s_upgrade_effort = FFTW_EXHAUSTIVE;
+          }
+        }
+#ifdef FFTW3F_THREADS
+        s_threads = std::max(1, std::min(4, int(boost::thread::hardware_concurrency())));
+        env = getenv("GFDM_FFTW_THREADS");
+        if(env != 0){
+          s_threads = std::max(1, std::atoi(env));
+        }
+#endif
+        env = getenv("GFDM_FFTW_THREADS_MIN_LEN");
+        if(env != 0){
+          s_threads_min_len = std::max(1, std::atoi(env));
+        }
+        s_queue = new upgrade_queue();
+        s_queue->pending = 0;
+        boost::thread t(&planner_thread);
+        t.detach();
+        // constructed first, so finish_upgrades() runs before it is destroyed.
+        planner_mutex();
+        std::atexit(&finish_upgrades);
+      }
+    }
+
+    fft_plan::fft_plan(int fft_len, gfdm_complex* in, gfdm_complex* out, bool forward)
+      : d_fft_len(fft_len), d_nthreads(threads_for(fft_len)), d_in(in), d_out(out), d_state(new state())
+    {
+      d_state->fft_len = fft_len;
+      d_state->nthreads = d_nthreads;
+      d_state->forward = forward;
+      d_state->in_place = (in == out);
+      d_state->upgraded = 0;
+
+      fftwf_complex* fin = reinterpret_cast<fftwf_complex *>(in);
+      fftwf_complex* fout = reinterpret_cast<fftwf_complex *>(out);
+      const int sign = forward ? FFTW_FORWARD : FFTW_BACKWARD;
+      // a plan made for aligned scratch buffers must only run on aligned buffers.
+      const bool aligned = fftwf_alignment_of((float*) in) == 0 && fftwf_alignment_of((float*) out) == 0;
+      bool need_upgrade = false;
+      {
+        boost::mutex::scoped_lock lock(planner_mutex());
+        load_wisdom();
+        plan_with_nthreads(d_nthreads);
+        // ESTIMATE and WISDOM_ONLY planning leave the buffers untouched.
+        d_state->initial = 0;
+        if(s_upgrade_effort != FFTW_ESTIMATE){
+          d_state->initial = fftwf_plan_dft_1d(fft_len, fin, fout, sign, s_upgrade_effort | FFTW_WISDOM_ONLY);
+        }
+        if(d_state->initial){
+          d_state->upgraded = d_state->initial;
+          d_state->initial = 0;
+        }else{
+          d_state->initial = fftwf_plan_dft_1d(fft_len, fin, fout, sign, FFTW_ESTIMATE);
+          need_upgrade = aligned && s_upgrade_effort != FFTW_ESTIMATE;
+        }
+        plan_with_nthreads(1);
+      }
+      d_state->current.store(d_state->upgraded ? d_state->upgraded : d_state->initial);
+
+      if(need_upgrade){
+        boost::mutex::scoped_lock lock(s_queue->mutex);
+        s_queue->jobs.push_back(d_state);
+        s_queue->pending++;
+        s_queue->cond.notify_one();
+      }
+    }
+
+    fft_plan::~fft_plan()
+    {
+    }
+
+    void
+    fft_plan::execute()
+    {
+      fftwf_execute_dft(d_state->current.load(boost::memory_order_acquire),
+                        reinterpret_cast<fftwf_complex *>(d_in),
+                        reinterpret_cast<fftwf_complex *>(d_out));
+    }
+
+    bool
+    fft_plan::upgraded() const
+    {
+      return d_state->current.load(boost::memory_order_acquire) != d_state->initial;
+    }
+
+    void
+    fft_plan::set_upgrade_effort(unsigned flags)
+    {
+      boost::call_once(s_init_once, &init);
+      boost::mutex::scoped_lock lock(planner_mutex());
+      s_upgrade_effort = flags;
+    }
+
+    unsigned
+    fft_plan::upgrade_effort()
+    {
+      boost::call_once(s_init_once, &init);
+      boost::mutex::scoped_lock lock(planner_mutex());
+      return s_upgrade_effort;
+    }
+
+    void
+    fft_plan::wait_for_upgrades()
+    {
+      boost::call_once(s_init_once, &init);
+      boost::mutex::scoped_lock lock(s_queue->mutex);
+      while(s_queue->pending > 0){
+        s_queue->done_cond.wait(lock);
+      }
+    }
+
+    void
+    fft_plan::set_threads(int nthreads)
+    {
+      if(nthreads < 1){
+        throw std::invalid_argument("fft_plan: nthreads MUST be at least 1");
+      }
+      boost::call_once(s_init_once, &init);
+      boost::mutex::scoped_lock lock(planner_mutex());
+#ifdef FFTW3F_THREADS
+      s_threads = nthreads;
+#endif
+    }
+
+    int
+    fft_plan::threads()
+    {
+      boost::call_once(s_init_once, &init);
+      boost::mutex::scoped_lock lock(planner_mutex());
+      return s_threads;
+    }
+
+    void
+    fft_plan::set_threads_min_len(int fft_len)
+    {
+      if(fft_len < 1){
+        throw std::invalid_argument("fft_plan: threads_min_len MUST be at least 1");
+      }
+      boost::call_once(s_init_once, &init);
+      boost::mutex::scoped_lock lock(planner_mutex());
+      s_threads_min_len = fft_len;
+    }
+
+    int
+    fft_plan::threads_min_len()
+    {
+      boost::call_once(s_init_once, &init);
+      boost::mutex::scoped_lock lock(planner_mutex());
+      return s_threads_min_len;
+    }
+
+    int
+    fft_plan::threads_for(int fft_len)
+    {
+      boost::call_once(s_init_once, &init);
+      boost::mutex::scoped_lock lock(planner_mutex());
+      return fft_len >= s_threads_min_len ? s_threads : 1;
+    }
+
+    void
+    fft_plan::set_planner_mutex(boost::mutex& mutex)
+    {
+      s_planner_mutex = &mutex;
+    }
+
+  } /* namespace gfdm */
+} /* namespace gr */
+
@@ -0,0 +1,45 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2016 Andrej Rode.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * The blocks share the FFTW planner with gr::fft, so gfdm-kernels plans
+ * under GNU Radio's planner mutex as soon as this library is loaded.
+ */
+
+#include <gfdm/fft_plan.h>
+#include <gnuradio/fft/fft.h>
+
+namespace gr {
+  namespace gfdm {
+
+    namespace {
+      struct planner_mutex_hook
+      {
+        planner_mutex_hook()
+        {
+          fft_plan::set_planner_mutex(gr::fft::planner::mutex());
+        }
+      };
+
+      planner_mutex_hook s_planner_mutex_hook;
+    }
+
+  } /* namespace gfdm */
+} /* namespace gr */
@@ -0,0 +1,176 @@
+/* -*- c++ -*- */
+/* 
+ * Copyright 2016 Andrej Rode.
+ * 
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ * 
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gnuradio/io_signature.h>
+#include "frame_receiver_cc_impl.h"
+#include <gfdm/tracer.h>
+#include <boost/bind.hpp>
+#include <algorithm>
+
+namespace gr {
+  namespace gfdm {
+
+    frame_receiver_cc::sptr
+    frame_receiver_cc::make(int nsubcarrier, int ntimeslots, double filter_alpha, int fft_len, int cp_length, int sync_fft_len, int ic_iter, gr::digital::constellation_sptr constellation, const std::string& gfdm_sync_tag_key, const std::string& gfdm_len_tag_key, bool sync_messages)
+    {
+      return gnuradio::get_initial_sptr
+        (new frame_receiver_cc_impl(nsubcarrier, ntimeslots, filter_alpha, fft_len, cp_length, sync_fft_len, ic_iter, constellation, gfdm_sync_tag_key, gfdm_len_tag_key, sync_messages));
+    }
+
+    /*
+     * The private constructor
+     */
+    frame_receiver_cc_impl::frame_receiver_cc_impl(int nsubcarrier, int ntimeslots, double filter_alpha, int fft_len, int cp_length, int sync_fft_len, int ic_iter, gr::digital::constellation_sptr constellation, const std::string& gfdm_sync_tag_key, const std::string& gfdm_len_tag_key, bool sync_messages)
+      : gr::block("frame_receiver_cc",
+              gr::io_signature::make(1, 1, sizeof(gr_complex)),
+              gr::io_signature::make(1, 1, sizeof(gr_complex))),
+      gfdm_receiver(nsubcarrier, ntimeslots, filter_alpha, fft_len),
+      d_cp_length(cp_length),
+      d_sync_fft_len(sync_fft_len),
+      d_block_len(2*cp_length+fft_len+sync_fft_len),
+      // sync tag sits on the first preamble sample: preamble, CP, then data
+      d_data_offset(sync_fft_len+cp_length),
+      d_ic_iter(ic_iter),
+      d_constellation(constellation),
+      d_constellation_points(constellation ? constellation->points() : std::vector<gr_complex>()),
+      d_sync_messages(sync_messages),
+      d_sync_processed(0)
+    {
+      d_gfdm_sync_tag_key = pmt::string_to_symbol(gfdm_sync_tag_key);
+      d_gfdm_len_tag_key = pmt::string_to_symbol(gfdm_len_tag_key);
+      message_port_register_in(pmt::mp("sync"));
+      set_msg_handler(pmt::mp("sync"), boost::bind(&frame_receiver_cc_impl::handle_sync, this, _1));
+      set_output_multiple(d_N);
+      set_relative_rate(double(d_N)/double(d_block_len));
+      set_tag_propagation_policy(TPP_DONT);
+    }
+
+    /*
+     * Our virtual destructor.
+     */
+    frame_receiver_cc_impl::~frame_receiver_cc_impl()
+    {
+    }
+
+    void
+    frame_receiver_cc_impl::set_ic(int ic_iter)
+    {
+      gr::thread::scoped_lock guard(d_setlock);
+      d_ic_iter = ic_iter;
+    }
+
+    void
+    frame_receiver_cc_impl::handle_sync(pmt::pmt_t msg)
+    {
+      // sync_cc publishes a dict per frame and one with the processed position per call
+      gr::thread::scoped_lock guard(d_setlock);
+      const pmt::pmt_t offset = pmt::dict_ref(msg, pmt::mp("offset"), pmt::PMT_NIL);
+      if (!pmt::is_null(offset))
+      {
+        d_frame_starts.push_back(pmt::to_uint64(offset));
+      }
+      const pmt::pmt_t processed = pmt::dict_ref(msg, pmt::mp("processed"), pmt::PMT_NIL);
+      if (!pmt::is_null(processed))
+      {
+        d_sync_processed = pmt::to_uint64(processed);
+      }
+    }
+
+    void
+    frame_receiver_cc_impl::frames_from_tags(std::vector<uint64_t>& frame_starts, uint64_t nread, int ninput_items)
+    {
+      std::vector<tag_t> sync_tags;
+      get_tags_in_range(sync_tags, 0, nread, nread+ninput_items, d_gfdm_sync_tag_key);
+      for (std::vector<tag_t>::iterator it = sync_tags.begin(); it != sync_tags.end(); ++it)
+      {
+        frame_starts.push_back(it->offset);
+      }
+    }
+
+    void
+    frame_receiver_cc_impl::forecast (int noutput_items, gr_vector_int &ninput_items_required)
+    {
+      // one frame per d_N output items, the first one may start anywhere in the window
+      ninput_items_required[0] = (noutput_items/d_N)*d_block_len;
+    }
+
+    int
+    frame_receiver_cc_impl::general_work (int noutput_items,
+                       gr_vector_int &ninput_items,
+                       gr_vector_const_void_star &input_items,
+                       gr_vector_void_star &output_items)
+    {
+      const gr_complex *in = (const gr_complex *) input_items[0];
+      gr_complex *out = (gr_complex *) output_items[0];
+      const uint64_t nread = nitems_read(0);
+      trace_span span("frame_receiver_cc::work");
+
+      std::vector<uint64_t> frame_starts;
+      int nconsume;
+      if (d_sync_messages)
+      {
+        // Samples sync_cc has not searched yet may still hold a frame start.
+        frame_starts.assign(d_frame_starts.begin(), d_frame_starts.end());
+        nconsume = d_sync_processed > nread ? int(std::min(d_sync_processed - nread, uint64_t(ninput_items[0]))) : 0;
+      }else
+      {
+        // Without an incomplete frame all input can go.
+        frames_from_tags(frame_starts, nread, ninput_items[0]);
+        nconsume = ninput_items[0];
+      }
+
+      int nproduced = 0;
+      std::vector<uint64_t>::iterator it = frame_starts.begin();
+      for (; it != frame_starts.end(); ++it)
+      {
+        if (*it < nread)
+        {
+          continue;
+        }
+        const int sync_start = std::min(*it - nread, uint64_t(ninput_items[0]));
+        const int data_start = sync_start + d_data_offset;
+        if (data_start + d_fft_len > ninput_items[0] || nproduced + d_N > noutput_items)
+        {
+          // Frame straddles this call (or no room left): keep it from its tag on.
+          nconsume = std::min(nconsume, sync_start);
+          break;
+        }
+        gfdm_work_ic(&out[nproduced], &in[data_start], d_ic_iter, d_constellation_points);
+        add_item_tag(0, nitems_written(0)+nproduced, d_gfdm_len_tag_key, pmt::from_long(d_N));
+        nproduced += d_N;
+      }
+      if (d_sync_messages)
+      {
+        d_frame_starts.erase(d_frame_starts.begin(), d_frame_starts.begin() + (it - frame_starts.begin()));
+      }
+
+      span.set_frames(nproduced / d_N);
+      consume_each(nconsume);
+      return nproduced;
+    }
+
+  } /* namespace gfdm */
+} /* namespace gr */
+
@@ -0,0 +1,84 @@
+/* -*- c++ -*- */
+/* 
+ * Copyright 2016 Andrej Rode.
+ * 
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ * 
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef INCLUDED_GFDM_FRAME_RECEIVER_CC_IMPL_H
+#define INCLUDED_GFDM_FRAME_RECEIVER_CC_IMPL_H
+
+#include <gfdm/frame_receiver_cc.h>
+#include <gfdm/gfdm_receiver.h>
+#include <pmt/pmt.h>
+#include <deque>
+
+namespace gr {
+  namespace gfdm {
+
+    class frame_receiver_cc_impl : public frame_receiver_cc, public kernel::gfdm_receiver
+    {
+     private:
+       int d_cp_length;
+       int d_sync_fft_len;
+       int d_block_len;
+       int d_data_offset;
+       int d_ic_iter;
+       gr::digital::constellation_sptr d_constellation;
+       //! decision points of d_constellation for the SIC in gfdm_receiver
+       std::vector<gr_complex> d_constellation_points;
+       pmt::pmt_t d_gfdm_sync_tag_key;
+       pmt::pmt_t d_gfdm_len_tag_key;
+       bool d_sync_messages;
+       //! absolute frame starts announced on the "sync" port, not demodulated yet
+       std::deque<uint64_t> d_frame_starts;
+       //! input items sync_cc has searched so far
+       uint64_t d_sync_processed;
+
+       void handle_sync(pmt::pmt_t msg);
+       void frames_from_tags(std::vector<uint64_t>& frame_starts, uint64_t nread, int ninput_items);
+
+     public:
+      frame_receiver_cc_impl(
+          int nsubcarrier,
+          int ntimeslots,
+          double filter_alpha,
+          int fft_len,
+          int cp_length,
+          int sync_fft_len,
+          int ic_iter,
+          gr::digital::constellation_sptr constellation,
+          const std::string& gfdm_sync_tag_key,
+          const std::string& gfdm_len_tag_key,
+          bool sync_messages);
+      ~frame_receiver_cc_impl();
+      void set_ic(int ic_iter);
+
+      // Where all the action really happens
+      void forecast (int noutput_items, gr_vector_int &ninput_items_required);
+
+      int general_work(int noutput_items,
+           gr_vector_int &ninput_items,
+           gr_vector_const_void_star &input_items,
+           gr_vector_void_star &output_items);
+    };
+
+  } // namespace gfdm
+} // namespace gr
+
+#endif /* INCLUDED_GFDM_FRAME_RECEIVER_CC_IMPL_H */
+
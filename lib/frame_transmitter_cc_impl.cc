@@ -0,0 +1,143 @@
+/* -*- c++ -*- */
+/* 
+ * Copyright 2016 Andrej Rode.
+ * 
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ * 
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gnuradio/io_signature.h>
+#include "frame_transmitter_cc_impl.h"
+#include <gfdm/tracer.h>
+#include <gfdm/gfdm_utils.h>
+
+namespace gr {
+  namespace gfdm {
+
+    frame_transmitter_cc::sptr
+    frame_transmitter_cc::make(int n_timeslots, int n_subcarriers, int overlap, std::vector<gr_complex> frequency_taps,
+                               int cp_length, int ramp_len, std::vector<gr_complex> window_taps,
+                               gr::gfdm::preamble_generator_sptr preamble_generator,
+                               const std::string& len_tag_key)
+    {
+      return gnuradio::get_initial_sptr
+        (new frame_transmitter_cc_impl(n_timeslots, n_subcarriers, overlap, frequency_taps,
+                                       cp_length, ramp_len, window_taps, preamble_generator, len_tag_key));
+    }
+
+    /*
+     * The private constructor
+     */
+    frame_transmitter_cc_impl::frame_transmitter_cc_impl(int n_timeslots, int n_subcarriers, int overlap, std::vector<gr_complex> frequency_taps,
+                                                         int cp_length, int ramp_len, std::vector<gr_complex> window_taps,
+                                                         gr::gfdm::preamble_generator_sptr preamble_generator,
+                                                         const std::string& len_tag_key)
+      : gr::block("frame_transmitter_cc",
+              gr::io_signature::make(1, 1, sizeof(gr_complex)),
+              gr::io_signature::make(1, 1, sizeof(gr_complex))),
+      d_n_timeslots(n_timeslots),
+      d_n_subcarriers(n_subcarriers),
+      d_cp_length(cp_length),
+      d_preamble_part_len(0)
+    {
+      // all the work is done in the kernels!
+      d_modulator = modulator_kernel_cc::sptr(
+              new modulator_kernel_cc(n_timeslots, n_subcarriers, overlap, frequency_taps));
+      d_prefixer = add_cyclic_prefix_cc::sptr(
+              new add_cyclic_prefix_cc(ramp_len, cp_length, d_modulator->block_size(), window_taps));
+
+      if (preamble_generator) {
+        d_preamble = preamble_generator->get_preamble();
+        if (int(d_preamble.size()) < cp_length) {
+          throw std::invalid_argument("preamble MUST NOT be shorter than cp_length!");
+        }
+        d_preamble_part_len = cp_length + d_preamble.size();
+      }
+      d_frame_len = d_preamble_part_len + d_prefixer->frame_size();
+      d_symbols.resize(d_modulator->block_size());
+      d_tag_frames = !len_tag_key.empty();
+      d_len_tag_key = pmt::string_to_symbol(len_tag_key);
+
+      set_tag_propagation_policy(TPP_DONT);
+      set_relative_rate(1.0 * d_frame_len / d_modulator->block_size());
+      set_fixed_rate(true);
+      set_output_multiple(d_frame_len);
+    }
+
+    /*
+     * Our virtual destructor.
+     */
+    frame_transmitter_cc_impl::~frame_transmitter_cc_impl()
+    {
+    }
+
+    void
+    frame_transmitter_cc_impl::forecast (int noutput_items, gr_vector_int &ninput_items_required)
+    {
+      ninput_items_required[0] = fixed_rate_noutput_to_ninput(noutput_items);
+    }
+
+    int
+    frame_transmitter_cc_impl::fixed_rate_ninput_to_noutput(int ninput)
+    {
+      return (ninput / d_modulator->block_size()) * d_frame_len;
+    }
+
+    int
+    frame_transmitter_cc_impl::fixed_rate_noutput_to_ninput(int noutput)
+    {
+      return (noutput / d_frame_len) * d_modulator->block_size();
+    }
+
+    int
+    frame_transmitter_cc_impl::general_work (int noutput_items,
+                       gr_vector_int &ninput_items,
+                       gr_vector_const_void_star &input_items,
+                       gr_vector_void_star &output_items)
+    {
+      const gr_complex *in = (const gr_complex *) input_items[0];
+      gr_complex *out = (gr_complex *) output_items[0];
+      const int n_frames = std::min(noutput_items / d_frame_len, ninput_items[0] / d_modulator->block_size());
+      trace_span span("frame_transmitter_cc::work");
+      span.set_frames(n_frames);
+
+      for (int i = 0; i < n_frames; ++i) {
+        if (d_tag_frames) {
+          add_item_tag(0, nitems_written(0) + i * d_frame_len, d_len_tag_key, pmt::from_long(d_frame_len));
+        }
+        if (d_preamble_part_len) {
+          std::memcpy(out + d_cp_length, &d_preamble[0], sizeof(gr_complex) * d_preamble.size());
+          std::memcpy(out, &d_preamble[d_preamble.size() - d_cp_length], sizeof(gr_complex) * d_cp_length);
+          out += d_preamble_part_len;
+        }
+        transpose_symbols(&d_symbols[0], in, d_n_subcarriers, d_n_timeslots);
+        d_modulator->generic_work(out + d_cp_length, &d_symbols[0]);
+        d_prefixer->add_cyclic_prefix_in_place(out);
+        in += d_modulator->block_size();
+        out += d_prefixer->frame_size();
+      }
+
+      consume_each(n_frames * d_modulator->block_size());
+      return n_frames * d_frame_len;
+    }
+
+  } /* namespace gfdm */
+} /* namespace gr */
+
@@ -0,0 +1,70 @@
+/* -*- c++ -*- */
+/* 
+ * Copyright 2016 Andrej Rode.
+ * 
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ * 
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef INCLUDED_GFDM_FRAME_TRANSMITTER_CC_IMPL_H
+#define INCLUDED_GFDM_FRAME_TRANSMITTER_CC_IMPL_H
+
+#include <gfdm/frame_transmitter_cc.h>
+#include <gfdm/modulator_kernel_cc.h>
+#include <gfdm/add_cyclic_prefix_cc.h>
+#include <pmt/pmt.h>
+
+namespace gr {
+  namespace gfdm {
+
+    class frame_transmitter_cc_impl : public frame_transmitter_cc
+    {
+     private:
+      int d_n_timeslots;
+      int d_n_subcarriers;
+      int d_cp_length;
+      modulator_kernel_cc::sptr d_modulator;
+      add_cyclic_prefix_cc::sptr d_prefixer;
+      std::vector<gr_complex> d_preamble;
+      int d_preamble_part_len;
+      int d_frame_len;
+      std::vector<gr_complex> d_symbols;
+      bool d_tag_frames;
+      pmt::pmt_t d_len_tag_key;
+
+     public:
+      frame_transmitter_cc_impl(int n_timeslots, int n_subcarriers, int overlap, std::vector<gr_complex> frequency_taps,
+                                int cp_length, int ramp_len, std::vector<gr_complex> window_taps,
+                                gr::gfdm::preamble_generator_sptr preamble_generator,
+                                const std::string& len_tag_key);
+      ~frame_transmitter_cc_impl();
+
+      // Where all the action really happens
+      void forecast (int noutput_items, gr_vector_int &ninput_items_required);
+      int fixed_rate_ninput_to_noutput(int ninput);
+      int fixed_rate_noutput_to_ninput(int noutput);
+
+      int general_work(int noutput_items,
+           gr_vector_int &ninput_items,
+           gr_vector_const_void_star &input_items,
+           gr_vector_void_star &output_items);
+    };
+
+  } // namespace gfdm
+} // namespace gr
+
+#endif /* INCLUDED_GFDM_FRAME_TRANSMITTER_CC_IMPL_H */
+
@@ -24,6 +24,10 @@
 
 #include <gnuradio/io_signature.h>
 #include "framer_cc_impl.h"
+#include <gfdm/tracer.h>
+#include <gfdm/gfdm_utils.h>
+#include <algorithm>
+#include <cstring>
 
 namespace gr {
   namespace gfdm {
@@ -69,11 +73,17 @@ namespace gr {
           d_sync_symbols.resize(2 * d_nsubcarrier);
           std::memcpy(&d_sync_symbols[0], &sync_symbols[0], sizeof(gr_complex) * 2 * nsubcarrier);
         }
-        gr::block::set_output_multiple(d_nsubcarrier * d_ntimeslots + d_sync_symbols.size());
-      } else {
-        gr::block::set_output_multiple(d_nsubcarrier * d_ntimeslots);
       }
+      d_frame_len = d_nsubcarrier * d_ntimeslots + d_sync_symbols.size();
+      gr::block::set_output_multiple(d_frame_len);
 
+      // tag keys and values are the same for every frame
+      d_sync_tag_key = pmt::string_to_symbol("gfdm_sync");
+      d_data_tag_key = pmt::string_to_symbol("gfdm_data");
+      d_frame_tag_key = pmt::string_to_symbol(d_len_tag_key);
+      d_sync_tag_value = pmt::from_uint64(d_sync_symbols.size());
+      d_data_tag_value = pmt::from_uint64(d_ntimeslots * d_nsubcarrier);
+      d_frame_tag_value = pmt::from_long(d_frame_len);
     }
 
     /*
@@ -84,11 +94,7 @@ namespace gr {
 
     void
     framer_cc_impl::forecast(int noutput_items, gr_vector_int &ninput_items_required) {
-      if (d_sync) {
-        ninput_items_required[0] = d_ntimeslots * d_nsubcarrier + d_sync_symbols.size();
-      } else {
-        ninput_items_required[0] = d_ntimeslots * d_nsubcarrier;
-      }
+      ninput_items_required[0] = (noutput_items / d_frame_len) * d_ntimeslots * d_nsubcarrier;
     }
 
     int
@@ -96,38 +102,31 @@ namespace gr {
                                  gr_vector_int &ninput_items,
                                  gr_vector_const_void_star &input_items,
                                  gr_vector_void_star &output_items) {
+      trace_span span("framer_cc::work");
       const gr_complex *in = (const gr_complex *) input_items[0];
       gr_complex *out = (gr_complex *) output_items[0];
 
-      int sync_offset = 0;
-      if (d_sync) {
-        sync_offset = d_sync_symbols.size();
-//          for (int i=0; i<d_nsubcarrier; i++)
-//          {
-//            out[2*i+1] = d_sync_symbols[i];
-//            out[2*i] = d_sync_symbols[i];
-//          }
-        std::memcpy(&out[0], &d_sync_symbols[0], sizeof(gr_complex) * d_sync_symbols.size());
-        add_item_tag(0, nitems_written(0),
-                     pmt::string_to_symbol("gfdm_sync"),
-                     pmt::from_uint64(d_sync_symbols.size()));
-      }
-      add_item_tag(0, nitems_written(0) + sync_offset,
-                   pmt::string_to_symbol("gfdm_data"),
-                   pmt::from_uint64(d_ntimeslots * d_nsubcarrier));
-      add_item_tag(0, nitems_written(0),
-                   pmt::string_to_symbol("gfdm_frame"),
-                   pmt::from_long(d_ntimeslots * d_nsubcarrier + sync_offset));
-      for (int k = 0; k < d_nsubcarrier; k++) {
-        for (int m = 0; m < d_ntimeslots; m++) {
-          out[(k * d_ntimeslots) + m + sync_offset] = in[(m * d_nsubcarrier + k)];
+      const int block_len = d_ntimeslots * d_nsubcarrier;
+      const int sync_offset = d_sync_symbols.size();
+      const int n_frames = std::min(noutput_items / d_frame_len, ninput_items[0] / block_len);
+      span.set_frames(n_frames);
+      uint64_t frame_start = nitems_written(0);
 
+      for (int i = 0; i < n_frames; i++) {
+        if (d_sync) {
+          std::memcpy(&out[0], &d_sync_symbols[0], sizeof(gr_complex) * sync_offset);
+          add_item_tag(0, frame_start, d_sync_tag_key, d_sync_tag_value);
         }
+        add_item_tag(0, frame_start + sync_offset, d_data_tag_key, d_data_tag_value);
+        add_item_tag(0, frame_start, d_frame_tag_key, d_frame_tag_value);
+        transpose_symbols(out + sync_offset, in, d_nsubcarrier, d_ntimeslots);
+        in += block_len;
+        out += d_frame_len;
+        frame_start += d_frame_len;
       }
-      gr::block::consume_each(d_nsubcarrier * d_ntimeslots);
-      int new_noutput_items = d_nsubcarrier * d_ntimeslots + sync_offset;
 
-      return new_noutput_items;
+      gr::block::consume_each(n_frames * block_len);
+      return n_frames * d_frame_len;
     }
 
   } /* namespace gfdm */
@@ -22,6 +22,7 @@
 #define INCLUDED_GFDM_FRAMER_CC_IMPL_H
 
 #include <gfdm/framer_cc.h>
+#include <pmt/pmt.h>
 
 namespace gr {
   namespace gfdm {
@@ -34,6 +35,13 @@ namespace gr {
       bool d_sync;
       std::vector<gr_complex> d_sync_symbols;
       gr::gfdm::preamble_generator_sptr d_preamble_generator;
+      int d_frame_len;
+      pmt::pmt_t d_sync_tag_key;
+      pmt::pmt_t d_data_tag_key;
+      pmt::pmt_t d_frame_tag_key;
+      pmt::pmt_t d_sync_tag_value;
+      pmt::pmt_t d_data_tag_value;
+      pmt::pmt_t d_frame_tag_value;
 
     public:
       framer_cc_impl(
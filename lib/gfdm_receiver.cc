@@ -20,16 +20,20 @@
  * Boston, MA 02110-1301, USA.
  */
 
-#ifndef INCLUDED_GFDM_RECEIVER_H
-#define INCLUDED_GFDM_RECEIVER_H
-#endif
-
 #include <gfdm/gfdm_receiver.h>
+#include <gfdm/tracer.h>
+#include <gfdm/simd_kernels.h>
+#include <volk/volk.h>
+#include <algorithm>
+#include <cstring>
 
 namespace gr {
   namespace gfdm {
     namespace kernel {
-          
+
+      static const char* const receiver_stage_names[] = {"input_fft", "filter", "sc_ifft", "sic_decision",
+                                                         "sic_cancel", "serialize"};
+
       gfdm_receiver::gfdm_receiver(int nsubcarrier,
                                    int ntimeslots,
                                    double filter_alpha,
@@ -38,7 +42,8 @@ namespace gr {
         d_nsubcarrier(nsubcarrier),
         d_ntimeslots(ntimeslots),
         d_N(ntimeslots*nsubcarrier),
-        d_fft_len(fft_len)
+        d_fft_len(fft_len),
+        d_timers(receiver_stage_names, N_STAGES)
 
       {
         d_filter_width = 2;
@@ -46,84 +51,95 @@ namespace gr {
         rrc_filter_sparse *filter_gen = new rrc_filter_sparse(d_N,filter_alpha,d_filter_width,nsubcarrier,ntimeslots);
         filter_gen->get_taps(d_filter_taps);
         delete filter_gen;
+        // the filtered subcarrier is read starting half a filter length into the taps
+        d_rotated_filter_taps.resize(d_filter_taps.size());
+        std::rotate_copy(d_filter_taps.begin(), d_filter_taps.begin() + d_filter_taps.size() / 2,
+                         d_filter_taps.end(), d_rotated_filter_taps.begin());
       
         //Initialize input FFT
-        d_in_fft = new fft::fft_complex(d_fft_len,true,1);
-        d_in_fft_in = d_in_fft->get_inbuf();
-        d_in_fft_out = d_in_fft->get_outbuf();
+        d_in_fft_in = (gfdm_complex *) volk_malloc(sizeof(gfdm_complex)*d_fft_len, volk_get_alignment());
+        d_in_fft_out = (gfdm_complex *) volk_malloc(sizeof(gfdm_complex)*d_fft_len, volk_get_alignment());
+        d_in_fft = new fft_plan(d_fft_len,d_in_fft_in,d_in_fft_out,true);
       
         //Initialize IFFT per subcarrier
-        d_sc_ifft = new fft::fft_complex(d_ntimeslots,false,1);
-        d_sc_ifft_in = d_sc_ifft->get_inbuf();
-        d_sc_ifft_out = d_sc_ifft->get_outbuf();
+        d_sc_ifft_in = (gfdm_complex *) volk_malloc(sizeof(gfdm_complex)*d_ntimeslots, volk_get_alignment());
+        d_sc_ifft_out = (gfdm_complex *) volk_malloc(sizeof(gfdm_complex)*d_ntimeslots, volk_get_alignment());
+        d_sc_ifft = new fft_plan(d_ntimeslots,d_sc_ifft_in,d_sc_ifft_out,false);
         //Initialize vector of vectors for temporary subcarrier data
         d_sc_fdomain.resize(nsubcarrier);
-        for (std::vector< std::vector<gr_complex> >::iterator it = d_sc_fdomain.begin();it != d_sc_fdomain.end();++it)
+        for (std::vector< std::vector<gfdm_complex> >::iterator it = d_sc_fdomain.begin();it != d_sc_fdomain.end();++it)
         {
           it->resize(ntimeslots);
         }
         d_sc_symbols.resize(nsubcarrier);
-        for (std::vector< std::vector<gr_complex> >::iterator it = d_sc_symbols.begin();it != d_sc_symbols.end();++it)
+        for (std::vector< std::vector<gfdm_complex> >::iterator it = d_sc_symbols.begin();it != d_sc_symbols.end();++it)
         {
           it->resize(ntimeslots);
         }
+
+        //Interference of neighbouring subcarriers for SIC
+        d_ic_filter_taps.resize(d_ntimeslots);
+        // Only works for d_filter_width = 2
+        ::volk_32fc_x2_multiply_32fc(&d_ic_filter_taps[0],&d_filter_taps[0],&d_filter_taps[d_ntimeslots],d_ntimeslots);
+        d_sc_fft_in = (gfdm_complex *) volk_malloc(sizeof(gfdm_complex)*d_ntimeslots, volk_get_alignment());
+        d_sc_fft_out = (gfdm_complex *) volk_malloc(sizeof(gfdm_complex)*d_ntimeslots, volk_get_alignment());
+        d_sc_fft = new fft_plan(d_ntimeslots,d_sc_fft_in,d_sc_fft_out,true);
       }
      
       gfdm_receiver::~gfdm_receiver()
       {
         delete d_in_fft;
         delete d_sc_ifft;
+        delete d_sc_fft;
+        volk_free(d_in_fft_in);
+        volk_free(d_in_fft_out);
+        volk_free(d_sc_ifft_in);
+        volk_free(d_sc_ifft_out);
+        volk_free(d_sc_fft_in);
+        volk_free(d_sc_fft_out);
       }
       
       void
-      gfdm_receiver::filter_superposition(std::vector< std::vector<gr_complex> > &out,
-          const gr_complex in[] )
+      gfdm_receiver::filter_superposition(std::vector< std::vector<gfdm_complex> > &out,
+          const gfdm_complex in[] )
       {
-        ::volk_32fc_s32fc_multiply_32fc(&d_in_fft_in[0],&in[0],static_cast<gr_complex>(float(d_N)/float(d_fft_len)),d_fft_len);
-        //std::memcpy(&d_in_fft_in[0],&in[0],sizeof(gr_complex)*d_fft_len);
+        trace_span span("gfdm_receiver::filter_superposition");
+        ::volk_32fc_s32fc_multiply_32fc(&d_in_fft_in[0],&in[0],static_cast<gfdm_complex>(float(d_N)/float(d_fft_len)),d_fft_len);
+        //std::memcpy(&d_in_fft_in[0],&in[0],sizeof(gfdm_complex)*d_fft_len);
         d_in_fft->execute();
-        std::vector<gr_complex> fft_out(d_fft_len+d_ntimeslots*d_filter_width);
-        std::memcpy(&fft_out[0],&d_in_fft_out[0],sizeof(gr_complex)*d_fft_len);
-        std::memcpy(&fft_out[d_fft_len],&d_in_fft_out[0],sizeof(gr_complex)*d_ntimeslots*d_filter_width);
+        GFDM_STAGE_LAP(d_timers, STAGE_INPUT_FFT);
         for (int k=0; k<d_nsubcarrier; k++)
         {
-          std::vector<gr_complex> sc_postfft(d_ntimeslots*d_filter_width);
-          std::vector<gr_complex> sc_postfilter(d_ntimeslots*d_filter_width);
           //FFT output is not centered:
           //Subcarrier-Offset = d_fft_len/2 + (d_fft_len-d_N)/2 - ((d_filter_width-1)*(d_ntimeslots))/2 + k*d_ntimeslots ) modulo d_fft_len
           int sc_offset = (d_fft_len/2 + (d_fft_len - d_N)/2 - ((d_filter_width-1)*(d_ntimeslots))/2 + k*d_ntimeslots) % d_fft_len;
-          gr_complex * sc = &fft_out[sc_offset];
-          for (int n=0;n<d_filter_width*d_ntimeslots;n++)
-          {
-            sc_postfft[n] = sc[(n + (d_ntimeslots*d_filter_width)/2) % (d_ntimeslots*d_filter_width)];
-          }
-          ::volk_32fc_x2_multiply_32fc(&sc_postfilter[0],
-              &sc_postfft[0],&d_filter_taps[0],d_ntimeslots*d_filter_width);
-          // Only valid for d_filter_width = 2, write own kernel for complex addition
-          ::volk_32f_x2_add_32f((float*)&out[k][0],
-              (float*)(&sc_postfilter[0]),(float*)(&sc_postfilter[d_ntimeslots]),2*d_ntimeslots);
-          }
-
+          // gather, filter with the rotated taps and fold the d_filter_width parts
+          simd::gather_multiply_fold(&out[k][0], d_in_fft_out, d_fft_len, sc_offset,
+              &d_rotated_filter_taps[0], d_ntimeslots, d_filter_width);
+        }
+        GFDM_STAGE_LAP(d_timers, STAGE_FILTER);
       }
 
       void
-      gfdm_receiver::demodulate_subcarrier(std::vector< std::vector<gr_complex> > &out,
-          std::vector< std::vector<gr_complex> > &sc_fdomain)
+      gfdm_receiver::demodulate_subcarrier(std::vector< std::vector<gfdm_complex> > &out,
+          std::vector< std::vector<gfdm_complex> > &sc_fdomain)
       {
+        trace_span span("gfdm_receiver::demodulate_subcarrier");
         // 4. apply ifft on every filtered and superpositioned subcarrier
         for (int k=0; k<d_nsubcarrier; k++)
         {
-          std::vector<gr_complex> sc_postifft(d_ntimeslots);
-          std::memcpy(&d_sc_ifft_in[0],&sc_fdomain[k][0],sizeof(gr_complex)*d_ntimeslots);
+          std::vector<gfdm_complex> sc_postifft(d_ntimeslots);
+          std::memcpy(&d_sc_ifft_in[0],&sc_fdomain[k][0],sizeof(gfdm_complex)*d_ntimeslots);
           d_sc_ifft->execute();
-          ::volk_32fc_s32fc_multiply_32fc(&out[k][0],&d_sc_ifft_out[0],static_cast<gr_complex>(1.0/(float)d_ntimeslots),d_ntimeslots);
+          ::volk_32fc_s32fc_multiply_32fc(&out[k][0],&d_sc_ifft_out[0],static_cast<gfdm_complex>(1.0/(float)d_ntimeslots),d_ntimeslots);
         }
+        GFDM_STAGE_LAP(d_timers, STAGE_SC_IFFT);
 
       }
 
       void
-      gfdm_receiver::serialize_output(gr_complex out[],
-          std::vector< std::vector<gr_complex> > &sc_symbols)
+      gfdm_receiver::serialize_output(gfdm_complex out[],
+          std::vector< std::vector<gfdm_complex> > &sc_symbols)
       {
         for (int k=0; k<d_nsubcarrier; k++)
         {
@@ -135,11 +151,88 @@ namespace gr {
       }
 
       void
-      gfdm_receiver::gfdm_work(gr_complex out[],const gr_complex in[], int ninput_items, int noutputitems)
+      gfdm_receiver::gfdm_work(gfdm_complex out[],const gfdm_complex in[], int ninput_items, int noutputitems)
       {
+       GFDM_STAGE_BEGIN(d_timers);
        filter_superposition(d_sc_fdomain,in);
        demodulate_subcarrier(d_sc_symbols,d_sc_fdomain);
        serialize_output(out,d_sc_symbols);
+       GFDM_STAGE_LAP(d_timers, STAGE_SERIALIZE);
+       GFDM_STAGE_COMMIT(d_timers);
+      }
+
+      void
+      gfdm_receiver::gfdm_work_ic(gfdm_complex out[], const gfdm_complex in[], int ic_iter, const std::vector<gfdm_complex> &constellation_points)
+      {
+        GFDM_STAGE_BEGIN(d_timers);
+        filter_superposition(d_sc_fdomain,&in[0]);
+        demodulate_subcarrier(d_sc_symbols,d_sc_fdomain);
+        for (int j=0;j<ic_iter;j++)
+        {
+          trace_span span("gfdm_receiver::sic_iteration");
+          map_sc_symbols(d_sc_symbols,constellation_points);
+          GFDM_STAGE_LAP(d_timers, STAGE_SIC_DECISION);
+          remove_sc_interference(d_sc_symbols,d_sc_fdomain);
+          GFDM_STAGE_LAP(d_timers, STAGE_SIC_CANCEL);
+          //Should work since output is assigned after operation and no volk calls are in demodulate_subcarrier
+          demodulate_subcarrier(d_sc_symbols,d_sc_symbols);
+        }
+        serialize_output(&out[0],d_sc_symbols);
+        GFDM_STAGE_LAP(d_timers, STAGE_SERIALIZE);
+        GFDM_STAGE_COMMIT(d_timers);
+      }
+
+      void
+      gfdm_receiver::map_sc_symbols( std::vector< std::vector<gfdm_complex> > &sc_symbols, const std::vector<gfdm_complex> &constellation_points)
+      {
+        for (int k=0;k<d_nsubcarrier;k++)
+        {
+          for (int m=0;m<d_ntimeslots;m++)
+          {
+            // nearest point, first one wins ties
+            const gfdm_complex sample = sc_symbols[k][m];
+            size_t best = 0;
+            float best_dist = std::norm(sample - constellation_points[0]);
+            for (size_t i=1;i<constellation_points.size();i++)
+            {
+              const float dist = std::norm(sample - constellation_points[i]);
+              if (dist < best_dist)
+              {
+                best = i;
+                best_dist = dist;
+              }
+            }
+            sc_symbols[k][m] = constellation_points[best];
+          }
+        }
+      }
+
+      void
+      gfdm_receiver::remove_sc_interference(std::vector< std::vector<gfdm_complex> > &sc_symbols, std::vector< std::vector<gfdm_complex> > &sc_fdomain)
+      {
+        std::vector< std::vector<gfdm_complex> > prev_sc_symbols = sc_symbols;
+        std::vector<gfdm_complex> sc_tmp(d_ntimeslots);
+        std::vector<gfdm_complex> sc_zeros(d_ntimeslots);
+        for (int k=0; k<d_nsubcarrier; k++)
+        {
+          if(d_ntimeslots*d_nsubcarrier < d_N && ((k==0) || (k==d_nsubcarrier-1)))
+          {
+            if (k==0)
+            {
+              ::volk_32f_x2_add_32f((float*)&d_sc_fft_in[0],(float*)&prev_sc_symbols[((k+1)% d_nsubcarrier)][0],(float*)&sc_zeros[0],2*d_ntimeslots);
+            }else if(k==d_nsubcarrier-1){
+              ::volk_32f_x2_add_32f((float*)&d_sc_fft_in[0],(float*)&prev_sc_symbols[(((k-1) % d_nsubcarrier) + d_nsubcarrier ) % d_nsubcarrier][0],(float*)&sc_zeros[0],2*d_ntimeslots);
+            }
+          }else{
+            ::volk_32f_x2_add_32f((float*)&d_sc_fft_in[0],(float*)&prev_sc_symbols[(((k-1) % d_nsubcarrier) + d_nsubcarrier) % d_nsubcarrier][0],(float*)&prev_sc_symbols[((k+1)% d_nsubcarrier)][0],2*d_ntimeslots);
+          }
+          d_sc_fft->execute();
+          ::volk_32fc_x2_multiply_32fc(&sc_symbols[k][0],&d_ic_filter_taps[0],&d_sc_fft_out[0],d_ntimeslots);
+          ::volk_32f_x2_subtract_32f((float*)&sc_tmp[0],(float*)&sc_fdomain[k][0],(float*)&sc_symbols[k][0],2*d_ntimeslots);
+          ::std::memcpy(&sc_symbols[k][0],&sc_tmp[0],sizeof(gfdm_complex)*d_ntimeslots);
+
+        }
+
       }
 
     } /* namespace kernel */
@@ -25,11 +25,70 @@
 #endif
 
 #include <gfdm/gfdm_utils.h>
-#include <gnuradio/fft/fft.h>
+#include <gfdm/fft_plan.h>
+#include <cmath>
+#include <cstring>
 
 namespace gr {
   namespace gfdm {
-    
+
+    std::vector<float>
+    root_raised_cosine(double gain, double sampling_freq, double symbol_rate, double alpha, int ntaps)
+    {
+      ntaps |= 1;
+      const double spb = sampling_freq / symbol_rate;
+      std::vector<float> taps(ntaps);
+      double scale = 0;
+      for (int i=0;i<ntaps;i++)
+      {
+        double x1, x2, x3, num, den;
+        const double xindx = i - ntaps/2;
+        x1 = M_PI * xindx / spb;
+        x2 = 4 * alpha * xindx / spb;
+        x3 = x2 * x2 - 1;
+        if (std::fabs(x3) >= 0.000001)
+        {
+          if (i != ntaps/2)
+            num = std::cos((1+alpha)*x1) + std::sin((1-alpha)*x1) / (4*alpha*xindx/spb);
+          else
+            num = std::cos((1+alpha)*x1) + (1-alpha) * M_PI / (4*alpha);
+          den = x3 * M_PI;
+        }
+        else
+        {
+          // x = +-T/(4 alpha), the closed form divides by zero there
+          if (alpha == 1)
+          {
+            taps[i] = -1;
+            continue;
+          }
+          x3 = (1-alpha)*x1;
+          x2 = (1+alpha)*x1;
+          num = (std::sin(x2)*(1+alpha)*M_PI
+                 - std::cos(x3)*((1-alpha)*M_PI*spb)/(4*alpha*xindx)
+                 + std::sin(x3)*spb*spb/(4*alpha*xindx*xindx));
+          den = -32 * M_PI * alpha * alpha * xindx / spb;
+        }
+        taps[i] = 4 * alpha * num / den;
+        scale += taps[i];
+      }
+      for (int i=0;i<ntaps;i++)
+      {
+        taps[i] = taps[i] * gain / scale;
+      }
+      return taps;
+    }
+
+    void
+    transpose_symbols(std::complex<float>* p_out, const std::complex<float>* p_in, int nsubcarrier, int ntimeslots)
+    {
+      for (int k = 0; k < nsubcarrier; k++) {
+        for (int m = 0; m < ntimeslots; m++) {
+          p_out[k * ntimeslots + m] = p_in[m * nsubcarrier + k];
+        }
+      }
+    }
+
     rrc_filter_sparse::rrc_filter_sparse(
         int ntaps,
         double alpha,
@@ -37,44 +96,40 @@ namespace gr {
         int nsubcarrier,
         int ntimeslots)
     {
-      std::vector<float> filtertaps(ntaps);
-      std::vector<float> filtertaps_center = gr::filter::firdes::root_raised_cosine(
+      std::vector<float> filtertaps_center = root_raised_cosine(
           1.0,
           1.0,
           double(1.0/nsubcarrier),
           alpha,
           ntaps);
+      //Real taps go through a complex FFT
+      std::vector<gfdm_complex> in(ntaps);
+      std::vector<gfdm_complex> out(ntaps);
       for (int i=0;i<ntaps;i++)
       {
-        filtertaps[i] = filtertaps_center[(i+ntaps/2) % ntaps];
+        in[i] = filtertaps_center[(i+ntaps/2) % ntaps];
+      }
+      {
+        fft_plan filter_fft(ntaps, &in[0], &out[0], true);
+        filter_fft.execute();
       }
-      //Initialize FFT
-      fft::fft_real_fwd *filter_fft = new fft::fft_real_fwd(ntaps,1);
-      float *in = filter_fft->get_inbuf();
-      gr_complex *out = filter_fft->get_outbuf();
-      std::memset((void*) in, 0x00, sizeof(float)*ntaps);
-      //Copy Filtertaps in FFT Input
-      std::memcpy(&in[0], &filtertaps[0], sizeof(float)*ntaps);
-      filter_fft->execute();
       d_filter_taps.resize(ntimeslots*filter_width,0j);
       // Only works for d_filter_width = 2 needs some rework for d_filter_width other than 2
-      std::memcpy(&d_filter_taps[0], out, sizeof(gr_complex)*ntimeslots);
+      std::memcpy(&d_filter_taps[0], &out[0], sizeof(gfdm_complex)*ntimeslots);
       for (int i=0; i<ntimeslots-1; i++)
       {
         d_filter_taps[i+ntimeslots+1] = std::conj(d_filter_taps[ntimeslots-1-i]);
       }
-      delete filter_fft;
-
     };
     rrc_filter_sparse::~rrc_filter_sparse()
     {
 
     };
     void
-    rrc_filter_sparse::get_taps(std::vector<gr_complex> &out)
+    rrc_filter_sparse::get_taps(std::vector<gfdm_complex> &out)
     {
       out.resize(d_filter_taps.size());
-      std::memcpy(&out[0],&d_filter_taps[0],sizeof(gr_complex)*d_filter_taps.size());
+      std::memcpy(&out[0],&d_filter_taps[0],sizeof(gfdm_complex)*d_filter_taps.size());
     };
 
   } /* namespace gfdm */
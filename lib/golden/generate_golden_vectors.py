@@ -0,0 +1,180 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2016 Andrej Rode.
+#
+# This is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+#
+# This software is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this software; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+'''
+Generate golden vectors for the C++ kernel tests (lib/qa_*.cc) from pygfdm.
+
+Vectors are stored as interleaved float32 complex samples, the GNU Radio
+.cfile format, next to this script. Parameters here MUST match the ones in
+the corresponding C++ tests. Rerun this script only if a pygfdm reference
+changes on purpose.
+'''
+
+import os
+import sys
+import numpy as np
+
+GOLDEN_DIR = os.path.dirname(os.path.abspath(__file__))
+sys.path.insert(0, os.path.join(GOLDEN_DIR, '..', '..', 'python'))
+
+from pygfdm.filters import get_frequency_domain_filter
+from pygfdm.gfdm_modulation import gfdm_modulate_block
+from pygfdm.mapping import get_data_matrix, reshape_input
+from pygfdm.receiver import gfdm_rx_filsup, gfdm_rx_demod, gfdm_rx_sic
+from pygfdm.utils import get_random_qpsk, get_random_samples
+from pygfdm.cyclic_prefix import get_window_len, get_raised_cosine_ramp, add_cyclic_prefix, add_cyclic_starfix, pinch_block
+
+
+def write_cfile(name, data):
+    np.asarray(data, dtype=np.complex64).tofile(os.path.join(GOLDEN_DIR, name + '.cfile'))
+
+
+def modulator_vectors(alpha, M, K, L):
+    name = 'modulator_M{}_K{}_L{}'.format(M, K, L)
+    taps = get_frequency_domain_filter('rrc', alpha, M, K, L)
+    data = get_random_qpsk(M * K)
+    D = get_data_matrix(data, K, group_by_subcarrier=False)
+    write_cfile(name + '_taps', taps)
+    write_cfile(name + '_in', data)
+    write_cfile(name + '_out', gfdm_modulate_block(D, taps, M, K, L, False))
+
+
+def cyclic_prefix_vectors(block_len, cp_len, ramp_len, n_frames):
+    name = 'cyclic_prefix_B{}_CP{}_R{}'.format(block_len, cp_len, ramp_len)
+    data = get_random_samples(n_frames * block_len)
+
+    window_taps = get_raised_cosine_ramp(ramp_len, block_len + cp_len)
+    ref = np.concatenate([pinch_block(add_cyclic_prefix(b, cp_len), window_taps)
+                          for b in np.split(data, n_frames)])
+    write_cfile(name + '_window', window_taps)
+    write_cfile(name + '_in', data)
+    write_cfile(name + '_out', ref)
+
+    # cyclic suffix of ramp_len samples overlap-added onto the next frame.
+    frame_len = block_len + cp_len
+    window_taps = get_raised_cosine_ramp(ramp_len, block_len + cp_len + ramp_len)
+    ref = np.zeros(n_frames * frame_len + ramp_len, dtype=complex)
+    for i, b in enumerate(np.split(data, n_frames)):
+        ref[i * frame_len:(i + 1) * frame_len + ramp_len] += pinch_block(add_cyclic_starfix(b, cp_len, ramp_len),
+                                                                         window_taps)
+    write_cfile(name + '_suffix_window', window_taps)
+    write_cfile(name + '_suffix_out', ref[0:n_frames * frame_len])
+
+
+def preamble_correlator_vectors(preamble_len, fft_len, n_lags):
+    name = 'preamble_correlator_P{}_N{}'.format(preamble_len, fft_len)
+    preamble = get_random_qpsk(preamble_len)
+    data = get_random_samples(n_lags + preamble_len - 1)
+    # p_out[i] = 1/preamble_len * sum_k conj(preamble[k]) * p_in[i + k]
+    ref = np.correlate(data, preamble, 'valid') / preamble_len
+    write_cfile(name + '_spectrum', np.conj(np.fft.fft(preamble, fft_len)))
+    write_cfile(name + '_in', data)
+    write_cfile(name + '_out', ref)
+
+
+def nco_vectors(frequency, n_items):
+    name = 'nco_F{}'.format(n_items)
+    data = get_random_samples(n_items)
+    write_cfile(name + '_in', data)
+    write_cfile(name + '_out', data * np.exp(2j * np.pi * frequency * np.arange(n_items)))
+
+
+def root_raised_cosine(gain, sampling_freq, symbol_rate, alpha, ntaps):
+    # port of gr::gfdm::root_raised_cosine in lib/gfdm_utils.cc
+    ntaps |= 1
+    spb = sampling_freq / symbol_rate
+    taps = np.zeros(ntaps)
+    scale = 0.
+    for i in range(ntaps):
+        xindx = i - ntaps // 2
+        x1 = np.pi * xindx / spb
+        x2 = 4 * alpha * xindx / spb
+        x3 = x2 * x2 - 1
+        if abs(x3) >= 0.000001:
+            if i != ntaps // 2:
+                num = np.cos((1 + alpha) * x1) + np.sin((1 - alpha) * x1) / (4 * alpha * xindx / spb)
+            else:
+                num = np.cos((1 + alpha) * x1) + (1 - alpha) * np.pi / (4 * alpha)
+            den = x3 * np.pi
+        else:
+            if alpha == 1:
+                taps[i] = -1
+                continue
+            x3 = (1 - alpha) * x1
+            x2 = (1 + alpha) * x1
+            num = (np.sin(x2) * (1 + alpha) * np.pi
+                   - np.cos(x3) * ((1 - alpha) * np.pi * spb) / (4 * alpha * xindx)
+                   + np.sin(x3) * spb * spb / (4 * alpha * xindx * xindx))
+            den = -32 * np.pi * alpha * alpha * xindx / spb
+        taps[i] = 4 * alpha * num / den
+        scale += taps[i]
+    return taps * gain / scale
+
+
+def receiver_filter(alpha, M, K):
+    # port of gr::gfdm::rrc_filter_sparse for filter_width 2, as set up by gfdm_receiver
+    N = M * K
+    h = root_raised_cosine(1., 1., 1. / K, alpha, N)
+    H = np.fft.fft(h[(np.arange(N) + N // 2) % N])
+    H_sparse = np.zeros(2 * M, dtype=complex)
+    H_sparse[0:M] = H[0:M]
+    H_sparse[M + 1:] = np.conj(H[M - 1:0:-1])
+    return H_sparse
+
+
+def receiver_vectors(alpha, M, K, ic_iter):
+    name = 'receiver_M{}_K{}'.format(M, K)
+    N = M * K
+    L = 2
+    data = get_random_qpsk(N)
+    # time slot after time slot, the order gfdm_receiver outputs
+    D = get_data_matrix(data, K, group_by_subcarrier=True)
+    y = gfdm_modulate_block(D, get_frequency_domain_filter('rrc', alpha, M, K, L), M, K, L, False)
+    # modulator_kernel_cc puts subcarrier k on bin k*M, the receiver expects it centered on k*M + (M - N) / 2
+    y = y * np.exp(2j * np.pi * (M - N) / 2 * np.arange(N) / N)
+    y += 1e-3 * get_random_samples(N)
+
+    # gfdm_rx_fft2 without its 1/K input scaling and with the receiver taps of gfdm_receiver
+    H_sparse = receiver_filter(alpha, M, K)
+    Y_fs = gfdm_rx_filsup(np.fft.fftshift(np.fft.fft(y)), H_sparse, M, K, L)
+    d_rx = gfdm_rx_demod(Y_fs, K)
+    # gfdm_rx_sic scales the interference taps by 1/K ** 2, gfdm_receiver does not
+    d_sic = gfdm_rx_sic(K, M, ic_iter, K * H_sparse, d_rx, Y_fs, 4)
+    assert np.all(np.sign(reshape_input(d_sic, K, M).real) == np.sign(data.real))
+    write_cfile(name + '_in', y)
+    write_cfile(name + '_out', reshape_input(d_rx, K, M))
+    write_cfile(name + '_sic{}_out'.format(ic_iter), reshape_input(d_sic, K, M))
+
+
+def main():
+    np.random.seed(42)
+    modulator_vectors(.5, 8, 4, 2)
+    modulator_vectors(.35, 15, 16, 2)
+    modulator_vectors(.2, 9, 8, 4)
+    cyclic_prefix_vectors(64, 8, 4, 3)
+    preamble_correlator_vectors(32, 64, 100)
+    nco_vectors(0.0123, 1000)
+    receiver_vectors(.2, 16, 16, 2)
+    receiver_vectors(.5, 8, 32, 2)
+
+
+if __name__ == '__main__':
+    main()
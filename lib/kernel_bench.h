@@ -0,0 +1,266 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2016 Andrej Rode.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_GFDM_KERNEL_BENCH_H
+#define INCLUDED_GFDM_KERNEL_BENCH_H
+
+/*
+ * Timed kernel cases shared by bench-gfdm and the performance regression
+ * tests in test-gfdm. Every case processes one frame per run().
+ */
+
+#include <gfdm/modulator_kernel_cc.h>
+#include <gfdm/add_cyclic_prefix_cc.h>
+#include <gfdm/gfdm_receiver.h>
+#include <gfdm/gfdm_utils.h>
+#include <gfdm/preamble_generator.h>
+#include <gfdm/fft_plan.h>
+#include <gfdm/sync_kernel_cc.h>
+#include <gnuradio/high_res_timer.h>
+#include <gnuradio/digital/constellation.h>
+#include <boost/shared_ptr.hpp>
+#include <vector>
+#include <string>
+#include <sstream>
+#include <cstdlib>
+#include <cmath>
+
+namespace gr {
+  namespace gfdm {
+    namespace bench {
+
+      typedef std::complex<float> gfdm_complex;
+
+      //! fft_len is the receiver input length (>= K * M), the sync cases use it as sync fft_len.
+      struct params_t { int K; int M; int L; int fft_len; };
+
+      //! One timed operation. run() processes a single frame.
+      class bench_case
+      {
+      public:
+        virtual ~bench_case(){}
+        virtual void run() = 0;
+        //! items processed by one run(), used for MSamples/s.
+        virtual int items() = 0;
+      };
+
+      inline std::vector<gfdm_complex>
+      random_symbols(int n)
+      {
+        const float a = 1.0f / std::sqrt(2.0f);
+        std::vector<gfdm_complex> v(n);
+        for(int i = 0; i < n; i++){
+          v[i] = gfdm_complex((std::rand() % 2) ? a : -a, (std::rand() % 2) ? a : -a);
+        }
+        return v;
+      }
+
+      inline std::vector<gfdm_complex>
+      frequency_taps(const params_t& p)
+      {
+        std::vector<gfdm_complex> taps;
+        // rrc_filter_sparse only designs L=2 filters, bench-gfdm rejects other overlaps.
+        rrc_filter_sparse filter(p.K * p.M, 0.5, p.L, p.K, p.M);
+        filter.get_taps(taps);
+        taps.resize(p.M * p.L, gfdm_complex(0.0f, 0.0f));
+        return taps;
+      }
+
+      class modulator_case : public bench_case
+      {
+        modulator_kernel_cc d_kernel;
+        std::vector<gfdm_complex> d_in, d_out;
+      public:
+        modulator_case(const params_t& p)
+          : d_kernel(p.M, p.K, p.L, frequency_taps(p)),
+            d_in(random_symbols(p.K * p.M)), d_out(p.K * p.M) {}
+        void run(){ d_kernel.generic_work(&d_out[0], &d_in[0]); }
+        int items(){ return d_kernel.block_size(); }
+      };
+
+      class cyclic_prefix_case : public bench_case
+      {
+        add_cyclic_prefix_cc d_kernel;
+        std::vector<gfdm_complex> d_in, d_out;
+      public:
+        cyclic_prefix_case(const params_t& p, bool cyclic_suffix)
+          : d_kernel(p.K / 2, p.K, p.K * p.M, std::vector<gfdm_complex>(p.K, 0.5f), cyclic_suffix),
+            d_in(random_symbols(p.K * p.M)), d_out(p.K * p.M + p.K) {}
+        void run(){ d_kernel.generic_work(&d_out[0], &d_in[0]); }
+        int items(){ return d_kernel.frame_size(); }
+      };
+
+      class receiver_case : public bench_case
+      {
+        kernel::gfdm_receiver d_kernel;
+        int d_ic_iter;
+        std::vector<gfdm_complex> d_constellation_points;
+        std::vector<gfdm_complex> d_in, d_out;
+      public:
+        receiver_case(const params_t& p, int ic_iter)
+          : d_kernel(p.K, p.M, 0.5, p.fft_len), d_ic_iter(ic_iter),
+            d_constellation_points(gr::digital::constellation_qpsk::make()->points()),
+            d_in(random_symbols(p.fft_len)), d_out(p.K * p.M) {}
+        void run()
+        {
+          if(d_ic_iter > 0){
+            d_kernel.gfdm_work_ic(&d_out[0], &d_in[0], d_ic_iter, d_constellation_points);
+          }
+          else{
+            d_kernel.gfdm_work(&d_out[0], &d_in[0], d_in.size(), d_out.size());
+          }
+        }
+        int items(){ return d_in.size(); }
+      };
+
+      //! Time slot major to subcarrier major reordering of framer_cc and frame_transmitter_cc.
+      class transpose_case : public bench_case
+      {
+        params_t d_p;
+        std::vector<gfdm_complex> d_in, d_out;
+      public:
+        transpose_case(const params_t& p)
+          : d_p(p), d_in(random_symbols(p.K * p.M)), d_out(p.K * p.M) {}
+        void run(){ transpose_symbols(&d_out[0], &d_in[0], d_p.K, d_p.M); }
+        int items(){ return d_in.size(); }
+      };
+
+      //! sync_cc detector stages on a frame worth of samples, cp_length K as in sync_cc's block length.
+      class sync_case : public bench_case
+      {
+      public:
+        enum stage_t { AUTOCORR, XCORR_TRACK, XCORR_SEARCH };
+      private:
+        sync_kernel_cc d_kernel;
+        stage_t d_stage;
+        int d_n;
+        std::vector<gfdm_complex> d_in, d_out;
+      public:
+        sync_case(const params_t& p, stage_t stage)
+          : d_kernel(preamble_generator_sptr(new preamble_generator(p.K, 0.5, p.fft_len)),
+                     2 * p.K + p.fft_len + p.K * p.M),
+            d_stage(stage)
+        {
+          // tracking correlates +-track_window lags (sync_cc default 8), search a whole frame.
+          d_n = (stage == XCORR_TRACK) ? 2 * 8 + 1 : p.K * p.M;
+          d_in = random_symbols(d_n + 2 * p.fft_len);
+          d_out.resize(d_n);
+        }
+        void run()
+        {
+          if(d_stage == AUTOCORR){
+            d_kernel.autocorrelate(&d_out[0], &d_in[0], d_n);
+          }
+          else{
+            d_kernel.correlate_window(&d_out[0], &d_in[0], d_n);
+          }
+        }
+        int items(){ return d_n; }
+      };
+
+      class rrc_case : public bench_case
+      {
+        params_t d_p;
+        std::vector<gfdm_complex> d_taps;
+      public:
+        rrc_case(const params_t& p) : d_p(p) {}
+        void run()
+        {
+          rrc_filter_sparse filter(d_p.K * d_p.M, 0.5, d_p.L, d_p.K, d_p.M);
+          filter.get_taps(d_taps);
+        }
+        int items(){ return d_p.K * d_p.M; }
+      };
+
+      //! Run c until min_seconds have passed, return ns per run().
+      inline double
+      time_case(bench_case& c, double min_seconds, long& n_runs)
+      {
+        // warm up caches and let lazy initialization happen outside the measurement.
+        for(int i = 0; i < 8; i++){
+          c.run();
+        }
+        const double tps = double(gr::high_res_timer_tps());
+        long batch = 1;
+        n_runs = 0;
+        gr::high_res_timer_type start = gr::high_res_timer_now();
+        double elapsed = 0.0;
+        while(elapsed < min_seconds){
+          for(long i = 0; i < batch; i++){
+            c.run();
+          }
+          n_runs += batch;
+          batch *= 2;
+          elapsed = (gr::high_res_timer_now() - start) / tps;
+        }
+        return 1e9 * elapsed / n_runs;
+      }
+
+      struct named_case_t {
+        std::string kernel;
+        params_t params;
+        boost::shared_ptr<bench_case> bench;
+      };
+
+      inline void
+      add_case(std::vector<named_case_t>& cases, const std::string& kernel, const params_t& p, bench_case* c)
+      {
+        named_case_t n = {kernel, p, boost::shared_ptr<bench_case>(c)};
+        cases.push_back(n);
+      }
+
+      //! All kernel cases for one (K, M, L) set and each of the given sync fft_len values.
+      inline std::vector<named_case_t>
+      make_cases(const params_t& p, const std::vector<int>& sync_fft_lens)
+      {
+        std::vector<named_case_t> cases;
+        add_case(cases, "modulator_kernel_cc", p, new modulator_case(p));
+        add_case(cases, "add_cyclic_prefix_cc", p, new cyclic_prefix_case(p, false));
+        add_case(cases, "add_cyclic_prefix_cc_suffix", p, new cyclic_prefix_case(p, true));
+        add_case(cases, "gfdm_receiver", p, new receiver_case(p, 0));
+        add_case(cases, "gfdm_receiver_sic2", p, new receiver_case(p, 2));
+        add_case(cases, "transpose_symbols", p, new transpose_case(p));
+        add_case(cases, "rrc_filter_sparse", p, new rrc_case(p));
+        for(size_t i = 0; i < sync_fft_lens.size(); i++){
+          params_t ps = p;
+          ps.fft_len = sync_fft_lens[i];
+          add_case(cases, "sync_kernel_cc_autocorrelate", ps, new sync_case(ps, sync_case::AUTOCORR));
+          add_case(cases, "sync_kernel_cc_xcorr_track", ps, new sync_case(ps, sync_case::XCORR_TRACK));
+          add_case(cases, "sync_kernel_cc_xcorr_search", ps, new sync_case(ps, sync_case::XCORR_SEARCH));
+        }
+        // time the final plans, not the FFTW_ESTIMATE ones the kernels start on.
+        fft_plan::wait_for_upgrades();
+        return cases;
+      }
+
+      //! Stable identifier of a case, e.g. "modulator_kernel_cc/K64_M15_L2_N960".
+      inline std::string
+      case_id(const named_case_t& c)
+      {
+        std::stringstream ss;
+        ss << c.kernel << "/K" << c.params.K << "_M" << c.params.M << "_L" << c.params.L << "_N" << c.params.fft_len;
+        return ss.str();
+      }
+
+    } /* namespace bench */
+  } /* namespace gfdm */
+} /* namespace gr */
+
+#endif /* INCLUDED_GFDM_KERNEL_BENCH_H */
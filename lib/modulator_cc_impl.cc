@@ -24,6 +24,10 @@
 
 #include <gnuradio/io_signature.h>
 #include "modulator_cc_impl.h"
+#include <gfdm/tracer.h>
+#include <gfdm/fft_plan.h>
+#include <gfdm/simd_kernels.h>
+#include <algorithm>
 
 namespace gr {
   namespace gfdm {
@@ -85,23 +89,19 @@ namespace gr {
       std::memcpy(d_filter_taps, &filter_taps[0], sizeof(gr_complex) * filter_taps.size());
 
       //Initialize FFT per subcarrier
-      d_sc_fft = new fft::fft_complex(d_ntimeslots,true,1);
-      d_sc_fft_in = d_sc_fft->get_inbuf();
-      d_sc_fft_out = d_sc_fft->get_outbuf();
+      d_sc_fft_in = (gr_complex*) volk_malloc(sizeof(gr_complex) * d_ntimeslots, volk_get_alignment());
+      d_sc_fft_out = (gr_complex*) volk_malloc(sizeof(gr_complex) * d_ntimeslots, volk_get_alignment());
+      d_sc_fft = new fft_plan(d_ntimeslots, d_sc_fft_in, d_sc_fft_out, true);
 
       //Initiailize sync FFTs in case there are sync symbols
-      d_sync_ifft = new fft::fft_complex(d_sync_fft_len, false, 1);
-      d_sync_ifft_in = d_sync_ifft->get_inbuf();
-      d_sync_ifft_out = d_sync_ifft->get_outbuf();
+      d_sync_ifft_in = (gr_complex*) volk_malloc(sizeof(gr_complex) * d_sync_fft_len, volk_get_alignment());
+      d_sync_ifft_out = (gr_complex*) volk_malloc(sizeof(gr_complex) * d_sync_fft_len, volk_get_alignment());
+      d_sync_ifft = new fft_plan(d_sync_fft_len, d_sync_ifft_in, d_sync_ifft_out, false);
 
       //Initialize resulting FFT
-      d_out_ifft = new fft::fft_complex(d_fft_len,false,1);
-      d_out_ifft_in = d_out_ifft->get_inbuf();
-      d_out_ifft_out = d_out_ifft->get_outbuf();
-
-      // holds intermediate data during frame modulation
-      d_sc_tmp = (gr_complex*) volk_malloc(d_filter_width * d_ntimeslots * sizeof(gr_complex), volk_get_alignment());
-
+      d_out_ifft_in = (gr_complex*) volk_malloc(sizeof(gr_complex) * d_fft_len, volk_get_alignment());
+      d_out_ifft_out = (gr_complex*) volk_malloc(sizeof(gr_complex) * d_fft_len, volk_get_alignment());
+      d_out_ifft = new fft_plan(d_fft_len, d_out_ifft_in, d_out_ifft_out, false);
     }
 
     /*
@@ -109,10 +109,16 @@ namespace gr {
      */
     modulator_cc_impl::~modulator_cc_impl()
     {
+      volk_free(d_filter_taps);
       delete d_sc_fft;
+      volk_free(d_sc_fft_in);
+      volk_free(d_sc_fft_out);
       delete d_sync_ifft;
+      volk_free(d_sync_ifft_in);
+      volk_free(d_sync_ifft_out);
       delete d_out_ifft;
-      volk_free(d_sc_tmp);
+      volk_free(d_out_ifft_in);
+      volk_free(d_out_ifft_out);
     }
 
     int
@@ -141,27 +147,29 @@ namespace gr {
     void
     modulator_cc_impl::modulate_gfdm_frame(gr_complex *out, const gr_complex *in)
     {
-      std::memset(d_sc_tmp, 0x00, d_filter_width * d_ntimeslots * sizeof(gr_complex));
       std::memset(d_out_ifft_in, 0x00, sizeof(gr_complex)*d_fft_len);
+      const int filter_len = d_filter_width * d_ntimeslots;
       for (int k = 0; k < d_nsubcarrier; k++) {
         // 1. FFT on subcarrier
         std::memcpy(d_sc_fft_in, in + k * d_ntimeslots, sizeof(gr_complex) * d_ntimeslots);
         d_sc_fft->execute();
-        // 2. Multiply  with filtertaps (times filter_width)
-        for (int l = 0; l < d_filter_width; l++) {
-          ::volk_32fc_x2_multiply_32fc(d_sc_tmp + l * d_ntimeslots, d_sc_fft_out,
-                                       d_filter_taps + l * d_ntimeslots, d_ntimeslots);
-        }
 
-        // 3. Add to ifft-vector
+        // 2. Multiply with filtertaps (times filter_width) and add to ifft-vector
         // Calculate ifft offset (not shifted, possibly longer than symbols, some outofband radiation, per subcarrier offset
         int ifft_offset = (d_fft_len / 2 + (d_fft_len - d_N) / 2 - ((d_filter_width - 1) * (d_ntimeslots)) / 2 +
                            k * d_ntimeslots) % d_fft_len;
 
-        // VOLKify me!
-        for (int n = 0; n < d_filter_width * d_ntimeslots; n++) {
-          d_out_ifft_in[((ifft_offset + n) % d_fft_len)] += d_sc_tmp[(n + (d_filter_width * d_ntimeslots) / 2) %
-                                                                   (d_filter_width * d_ntimeslots)];
+        // filter tap s lands at (s - filter_len/2) mod filter_len, the kernel wraps around fft_len.
+        for (int l = 0; l < d_filter_width; l++) {
+          int s = l * d_ntimeslots;
+          const int end = s + d_ntimeslots;
+          while (s < end) {
+            const int run_end = (s < filter_len / 2) ? std::min(end, filter_len / 2) : end;
+            const int n = (s + filter_len - filter_len / 2) % filter_len;
+            simd::multiply_circular_add(d_out_ifft_in, d_fft_len, (ifft_offset + n) % d_fft_len,
+                                        d_sc_fft_out + s - l * d_ntimeslots, d_filter_taps + s, run_end - s);
+            s = run_end;
+          }
         }
       }
       d_out_ifft->execute();
@@ -175,6 +183,8 @@ namespace gr {
                        gr_vector_const_void_star &input_items,
                        gr_vector_void_star &output_items)
     {
+        trace_span span("modulator_cc::work");
+        span.set_frames(1);
         const gr_complex *in = (const gr_complex *) input_items[0];
         gr_complex *out = (gr_complex *) output_items[0];
         std::vector <gr::tag_t> tags;
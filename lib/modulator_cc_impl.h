@@ -21,8 +21,8 @@
 #ifndef INCLUDED_GFDM_MODULATOR_CC_IMPL_H
 #define INCLUDED_GFDM_MODULATOR_CC_IMPL_H
 
-#include <gnuradio/fft/fft.h>
 #include <gfdm/modulator_cc.h>
+#include <gfdm/fft_plan.h>
 #include <gnuradio/filter/firdes.h>
 #include <pmt/pmt.h>
 #include <volk/volk.h>
@@ -42,17 +42,16 @@ namespace gr {
        int d_sync_fft_len;
        std::string d_len_tag_key;
        gr_complex* d_filter_taps;
-       fft::fft_complex *d_sc_fft;
+       fft_plan *d_sc_fft;
        gr_complex * d_sc_fft_in;
        gr_complex * d_sc_fft_out;
-       fft::fft_complex *d_sync_ifft;
+       fft_plan *d_sync_ifft;
        gr_complex * d_sync_ifft_in;
        gr_complex * d_sync_ifft_out;
-       fft::fft_complex *d_out_ifft;
+       fft_plan *d_out_ifft;
        gr_complex * d_out_ifft_in;
        gr_complex * d_out_ifft_out;
 
-        gr_complex* d_sc_tmp;
       // Nothing to declare in this block.
       void modulate_gfdm_frame(gr_complex *out, const gr_complex *in);
 
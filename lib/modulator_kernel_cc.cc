@@ -19,6 +19,8 @@
  */
 
 #include <gfdm/modulator_kernel_cc.h>
+#include <gfdm/tracer.h>
+#include <gfdm/simd_kernels.h>
 #include <iostream>
 #include <volk/volk.h>
 #include <string.h>
@@ -28,8 +30,11 @@
 namespace gr {
   namespace gfdm {
 
+    static const char* const modulator_stage_names[] = {"sub_fft", "filter", "ifft"};
+
     modulator_kernel_cc::modulator_kernel_cc(int n_timeslots, int n_subcarriers, int overlap, std::vector<gfdm_complex> frequency_taps):
-      d_n_timeslots(n_timeslots), d_n_subcarriers(n_subcarriers), d_ifft_len(n_timeslots * n_subcarriers), d_overlap(overlap)
+      d_n_timeslots(n_timeslots), d_n_subcarriers(n_subcarriers), d_ifft_len(n_timeslots * n_subcarriers), d_overlap(overlap),
+      d_timers(modulator_stage_names, N_STAGES)
     {
       if (int(frequency_taps.size()) != n_timeslots * overlap){
         std::stringstream sstm;
@@ -45,70 +50,44 @@ namespace gr {
       // first create input and output buffers for a new FFTW plan.
       d_sub_fft_in = (gfdm_complex *) volk_malloc(sizeof (gfdm_complex) * n_timeslots, volk_get_alignment ());
       d_sub_fft_out = (gfdm_complex *) volk_malloc(sizeof (gfdm_complex) * n_timeslots, volk_get_alignment ());
-      d_sub_fft_plan = initialize_fft(d_sub_fft_out, d_sub_fft_in, n_timeslots, true);
-
-      d_filtered = (gfdm_complex *) volk_malloc(sizeof (gfdm_complex) * n_timeslots, volk_get_alignment ());
+      d_sub_fft = new fft_plan(n_timeslots, d_sub_fft_in, d_sub_fft_out, true);
 
       d_ifft_in = (gfdm_complex *) volk_malloc(sizeof (gfdm_complex) * d_ifft_len, volk_get_alignment ());
       d_ifft_out = (gfdm_complex *) volk_malloc(sizeof (gfdm_complex) * d_ifft_len, volk_get_alignment ());
-      d_ifft_plan = initialize_fft(d_ifft_out, d_ifft_in, n_timeslots * n_subcarriers, false);
+      d_ifft = new fft_plan(n_timeslots * n_subcarriers, d_ifft_in, d_ifft_out, false);
     }
 
     modulator_kernel_cc::~modulator_kernel_cc()
     {
       volk_free(d_filter_taps);
-      fftwf_destroy_plan (d_sub_fft_plan);
+      delete d_sub_fft;
       volk_free(d_sub_fft_in);
       volk_free(d_sub_fft_out);
 
-      volk_free(d_filtered);
-
-      fftwf_destroy_plan(d_ifft_plan);
+      delete d_ifft;
       volk_free(d_ifft_in);
       volk_free(d_ifft_out);
     }
 
 
-    fftwf_plan
-    modulator_kernel_cc::initialize_fft(gfdm_complex *out_buf, gfdm_complex *in_buf, const int fft_size, bool forward)
-    {
-      std::string filename(getenv("HOME"));
-      filename += "/.gr_fftw_wisdom";
-      FILE *fpr = fopen (filename.c_str(), "r");
-      if (fpr != 0){
-        int r = fftwf_import_wisdom_from_file (fpr);
-        fclose (fpr);
-      }
-
-      fftwf_plan plan = fftwf_plan_dft_1d(fft_size,
-                                      reinterpret_cast<fftwf_complex *>(in_buf),
-                                      reinterpret_cast<fftwf_complex *>(out_buf),
-                                      forward ? FFTW_FORWARD : FFTW_BACKWARD,
-                                      FFTW_MEASURE);
-
-      FILE *fpw = fopen (filename.c_str(), "w");
-      if (fpw != 0){
-        fftwf_export_wisdom_to_file (fpw);
-        fclose (fpw);
-      }
-      return plan;
-    }
-
 
     void
     modulator_kernel_cc::generic_work(gfdm_complex* p_out, const gfdm_complex* p_in)
     {
+      trace_span span("modulator_kernel_cc::generic_work");
       // assume data symbols are stacked subcarrier-wise in 'in'.
       const int part_len = std::min(d_n_timeslots * d_overlap / 2, d_n_timeslots);
 
       // make sure we don't sum up old results.
       memset(d_ifft_in, 0x00, sizeof (gfdm_complex) * d_ifft_len);
+      GFDM_STAGE_BEGIN(d_timers);
 
       // perform modulation for each subcarrier separately
       for(int k = 0; k < d_n_subcarriers; ++k){
         // get items into subcarrier FFT
         memcpy(d_sub_fft_in, p_in, sizeof(gfdm_complex) * d_n_timeslots);
-        fftwf_execute(d_sub_fft_plan);
+        d_sub_fft->execute();
+        GFDM_STAGE_LAP(d_timers, STAGE_SUB_FFT);
 
         // handle each part separately. The length of a part should always be d_n_timeslots.
         // FIXME: Assumption and algorithm will probably fail for d_overlap = 1 (Should never be used though).
@@ -116,18 +95,20 @@ namespace gr {
           // calculate positions for next part to handle
           int src_part_pos = ((i + d_overlap / 2) % d_overlap) * d_n_timeslots;
           int target_part_pos = ((k + i + d_n_subcarriers - (d_overlap / 2)) % d_n_subcarriers) * d_n_timeslots;
-          // perform filtering operation!
-          volk_32fc_x2_multiply_32fc(d_filtered, d_sub_fft_out, d_filter_taps + src_part_pos, d_n_timeslots);
-          // add generated part at correct position.
-          volk_32f_x2_add_32f((float*) (d_ifft_in + target_part_pos), (float*) (d_ifft_in + target_part_pos), (float*) d_filtered, 2 * part_len);
+          // filter and add generated part at correct position in one pass.
+          simd::multiply_circular_add(d_ifft_in, d_ifft_len, target_part_pos,
+                                      d_sub_fft_out, d_filter_taps + src_part_pos, part_len);
         }
+        GFDM_STAGE_LAP(d_timers, STAGE_FILTER);
         p_in += d_n_timeslots;
       }
 
       // Back to time domain!
-      fftwf_execute(d_ifft_plan);
+      d_ifft->execute();
 //      memcpy(p_out, d_ifft_out, sizeof(gfdm_complex) * d_ifft_len);
       volk_32fc_s32fc_multiply_32fc(p_out, d_ifft_out, gfdm_complex(1.0 / d_ifft_len, 0), d_ifft_len);
+      GFDM_STAGE_LAP(d_timers, STAGE_IFFT);
+      GFDM_STAGE_COMMIT(d_timers);
     }
 
     const void
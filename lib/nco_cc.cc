@@ -0,0 +1,61 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2016 Andrej Rode.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <gfdm/nco_cc.h>
+#include <volk/volk.h>
+#include <cmath>
+
+namespace gr {
+  namespace gfdm {
+
+    nco_cc::nco_cc(double frequency)
+      : d_phasor(1.0, 0.0)
+    {
+      set_frequency(frequency);
+    }
+
+    nco_cc::~nco_cc()
+    {
+    }
+
+    void
+    nco_cc::set_frequency(double frequency)
+    {
+      d_frequency = frequency;
+      d_phase_incr = std::polar(1.0f, float(2.0 * M_PI * frequency));
+    }
+
+    void
+    nco_cc::set_phase(double phase)
+    {
+      d_phasor = std::polar(1.0f, float(phase));
+    }
+
+    void
+    nco_cc::rotate(gfdm_complex* p_out, const gfdm_complex* p_in, int n_items)
+    {
+      volk_32fc_s32fc_x2_rotator_32fc(p_out, p_in, d_phase_incr, &d_phasor, n_items);
+      // keep the phasor on the unit circle for long running streams.
+      d_phasor /= std::abs(d_phasor);
+    }
+
+  } /* namespace gfdm */
+} /* namespace gr */
+
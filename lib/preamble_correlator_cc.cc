@@ -0,0 +1,93 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2016 Andrej Rode.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <gfdm/preamble_correlator_cc.h>
+#include <volk/volk.h>
+#include <stdexcept>
+#include <algorithm>
+#include <cstdlib>
+#include <string.h>
+
+namespace gr {
+  namespace gfdm {
+
+    preamble_correlator_cc::preamble_correlator_cc(int preamble_len, std::vector<gfdm_complex> preamble_spectrum)
+      : d_preamble_len(preamble_len), d_fft_len(preamble_spectrum.size())
+    {
+      if(d_fft_len < d_preamble_len){
+        throw std::invalid_argument("preamble_spectrum length MUST be greater than or equal to preamble_len!");
+      }
+      // fold FFTW's missing 1/fft_len and the correlation normalization into the reference spectrum.
+      d_preamble_spectrum = (gfdm_complex*) volk_malloc(sizeof(gfdm_complex) * d_fft_len, volk_get_alignment());
+      volk_32fc_s32fc_multiply_32fc(d_preamble_spectrum, &preamble_spectrum[0],
+                                    gfdm_complex(1.0 / (float(d_fft_len) * float(d_preamble_len)), 0), d_fft_len);
+
+      d_fft_in = (gfdm_complex*) volk_malloc(sizeof(gfdm_complex) * d_fft_len, volk_get_alignment());
+      d_fft_out = (gfdm_complex*) volk_malloc(sizeof(gfdm_complex) * d_fft_len, volk_get_alignment());
+      d_fft = new fft_plan(d_fft_len, d_fft_in, d_fft_out, true);
+
+      // spectral product is formed in place in d_fft_out and transformed back from there.
+      d_ifft_out = (gfdm_complex*) volk_malloc(sizeof(gfdm_complex) * d_fft_len, volk_get_alignment());
+      d_ifft = new fft_plan(d_fft_len, d_fft_out, d_ifft_out, false);
+    }
+
+    preamble_correlator_cc::~preamble_correlator_cc()
+    {
+      volk_free(d_preamble_spectrum);
+      delete d_fft;
+      delete d_ifft;
+      volk_free(d_fft_in);
+      volk_free(d_fft_out);
+      volk_free(d_ifft_out);
+    }
+
+    int
+    preamble_correlator_cc::suggest_fft_len(int preamble_len, int n_lags)
+    {
+      // A single transform if it covers all lags, otherwise ~4x preamble_len is a good overlap-save trade-off.
+      const int single_shot_len = n_lags + preamble_len - 1;
+      int fft_len = 1;
+      while(fft_len < std::min(4 * preamble_len, single_shot_len) || fft_len < preamble_len){
+        fft_len <<= 1;
+      }
+      return fft_len;
+    }
+
+    void
+    preamble_correlator_cc::generic_work(gfdm_complex* p_out, const gfdm_complex* p_in, int n_lags)
+    {
+      // Overlap-save: every transform yields hop_len() lags free of circular wrap-around.
+      const int hop = hop_len();
+      for(int pos = 0; pos < n_lags; pos += hop){
+        const int n_valid = std::min(hop, n_lags - pos);
+        const int n_in = n_valid + d_preamble_len - 1;
+        memcpy(d_fft_in, p_in + pos, sizeof(gfdm_complex) * n_in);
+        memset(d_fft_in + n_in, 0x00, sizeof(gfdm_complex) * (d_fft_len - n_in));
+        d_fft->execute();
+
+        volk_32fc_x2_multiply_32fc(d_fft_out, d_fft_out, d_preamble_spectrum, d_fft_len);
+        d_ifft->execute();
+        memcpy(p_out + pos, d_ifft_out, sizeof(gfdm_complex) * n_valid);
+      }
+    }
+
+  } /* namespace gfdm */
+} /* namespace gr */
+
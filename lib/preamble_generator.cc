@@ -22,8 +22,12 @@
 #include "config.h"
 #endif
 
-#include <gnuradio/io_signature.h>
 #include <gfdm/preamble_generator.h>
+#include <gfdm/fft_plan.h>
+#include <volk/volk.h>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
 
 namespace gr {
   namespace gfdm {
@@ -40,29 +44,28 @@ namespace gr {
 
       for (int sc=0; sc<nsubcarrier;sc++)
       {
-        d_symbols[sc] = gr_complex(symbol_choices[std::rand() % 2],symbol_choices[std::rand() %2]);
+        d_symbols[sc] = gfdm_complex(symbol_choices[std::rand() % 2],symbol_choices[std::rand() %2]);
       }
       //Initialize stuff
-      std::vector<gr_complex> filter_taps(2*2);
+      std::vector<gfdm_complex> filter_taps(2*2);
       //Initialize IFFT
-      fft::fft_complex* ifft = new fft::fft_complex(sync_fft_len,false,1);
-      gr_complex* ifft_in = ifft->get_inbuf();
-      gr_complex* ifft_out = ifft->get_outbuf();
+      std::vector<gfdm_complex> ifft_in(sync_fft_len);
+      std::vector<gfdm_complex> ifft_out(sync_fft_len);
+      fft_plan ifft(sync_fft_len, &ifft_in[0], &ifft_out[0], false);
       //Initialize SC_FFT
-      fft::fft_complex* sc_fft = new fft::fft_complex(2,true,1);
-      gr_complex* sc_fft_in = sc_fft->get_inbuf();
-      gr_complex* sc_fft_out = sc_fft->get_outbuf();
+      gfdm_complex sc_fft_in[2];
+      gfdm_complex sc_fft_out[2];
+      fft_plan sc_fft(2, sc_fft_in, sc_fft_out, true);
       //Initialize SC_Filter
       rrc_filter_sparse* sc_filter = new gfdm::rrc_filter_sparse(2*nsubcarrier, filter_alpha, 2, nsubcarrier, 2);
       // Get sc filtertaps
       sc_filter->get_taps(filter_taps);
-      std::memset(&ifft_in[0],0x00,sizeof(gr_complex)*sync_fft_len);
       for (int sc=0; sc<nsubcarrier;sc++)
       {
-        std::vector<gr_complex> sc_tmp(2*2,0j);
+        std::vector<gfdm_complex> sc_tmp(2*2,0j);
         sc_fft_in[0] = d_symbols[sc];
         sc_fft_in[1] = d_symbols[sc];
-        sc_fft->execute();
+        sc_fft.execute();
                 
         for (int l=0; l<2;l++)
         {
@@ -76,10 +79,8 @@ namespace gr {
         }      
       
       }
-      ifft->execute();
-      ::volk_32fc_s32fc_multiply_32fc(&d_samp_preamble[0],&ifft_out[0], static_cast<gr_complex>(1.0/(2*nsubcarrier)),sync_fft_len);
-      delete ifft;
-      delete sc_fft;
+      ifft.execute();
+      ::volk_32fc_s32fc_multiply_32fc(&d_samp_preamble[0],&ifft_out[0], static_cast<gfdm_complex>(1.0/(2*nsubcarrier)),sync_fft_len);
       delete sc_filter;
 
     }
@@ -87,6 +88,22 @@ namespace gr {
     preamble_generator::~preamble_generator()
     {
     }
+
+    std::vector<preamble_generator::gfdm_complex>
+    preamble_generator::get_preamble_spectrum(int fft_len)
+    {
+      if (fft_len < d_sync_fft_len)
+      {
+        throw std::invalid_argument("fft_len must be greater than or equal to preamble length");
+      }
+      std::vector<gfdm_complex> spectrum(fft_len);
+      std::vector<gfdm_complex> fft_in(fft_len);
+      std::memcpy(&fft_in[0],&d_samp_preamble[0],sizeof(gfdm_complex)*d_sync_fft_len);
+      fft_plan fft(fft_len, &fft_in[0], &spectrum[0], true);
+      fft.execute();
+      ::volk_32fc_conjugate_32fc(&spectrum[0],&spectrum[0],fft_len);
+      return spectrum;
+    }
     
     preamble_generator::sptr
     preamble_generator::make(int nsubcarrier, double filter_alpha, int sync_fft_len)
@@ -0,0 +1,64 @@
+/* -*- c++ -*- */
+/* 
+ * Copyright 2016 Andrej Rode.
+ * 
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ * 
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "qa_add_cyclic_prefix_cc.h"
+#include "qa_golden.h"
+#include <gfdm/add_cyclic_prefix_cc.h>
+
+namespace gr {
+  namespace gfdm {
+
+    static const int block_len = 64;
+    static const int cp_len = 8;
+    static const int ramp_len = 4;
+    static const int n_frames = 3;
+
+    static void
+    check_prefixer(bool cyclic_suffix)
+    {
+      const std::string name = "cyclic_prefix_B64_CP8_R4";
+      const std::string mode = cyclic_suffix ? "_suffix" : "";
+      std::vector<golden::gfdm_complex> window = golden::read_cfile(name + mode + "_window");
+      std::vector<golden::gfdm_complex> in = golden::read_cfile(name + "_in");
+      std::vector<golden::gfdm_complex> ref = golden::read_cfile(name + mode + "_out");
+
+      add_cyclic_prefix_cc kernel(ramp_len, cp_len, block_len, window, cyclic_suffix);
+      std::vector<golden::gfdm_complex> res(n_frames * kernel.frame_size());
+      CPPUNIT_ASSERT_EQUAL(ref.size(), res.size());
+      for(int i = 0; i < n_frames; i++){
+        kernel.generic_work(&res[i * kernel.frame_size()], &in[i * kernel.block_size()]);
+      }
+      golden::assert_close(ref, &res[0]);
+    }
+
+    void
+    qa_add_cyclic_prefix_cc::t1_golden_window()
+    {
+      check_prefixer(false);
+    }
+
+    void
+    qa_add_cyclic_prefix_cc::t2_golden_cyclic_suffix()
+    {
+      check_prefixer(true);
+    }
+
+  } /* namespace gfdm */
+} /* namespace gr */
@@ -0,0 +1,105 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2016 Andrej Rode.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "qa_batch_kernels.h"
+#include "qa_golden.h"
+#include <gfdm/batch_kernels.h>
+#include <gfdm/gfdm_utils.h>
+#include <cmath>
+#include <cstdlib>
+
+namespace gr {
+  namespace gfdm {
+
+    namespace {
+      typedef golden::gfdm_complex gfdm_complex;
+
+      std::vector<gfdm_complex>
+      random_vector(int n)
+      {
+        std::vector<gfdm_complex> v(n);
+        for(int i = 0; i < n; i++){
+          v[i] = gfdm_complex(float(std::rand()) / RAND_MAX - 0.5f, float(std::rand()) / RAND_MAX - 0.5f);
+        }
+        return v;
+      }
+    }
+
+    void
+    qa_batch_kernels::t1_modulator_matches_kernel()
+    {
+      const int K = 16, M = 5, L = 2, n_frames = 7;
+      std::vector<gfdm_complex> taps;
+      rrc_filter_sparse(K * M, 0.5, L, K, M).get_taps(taps);
+      const std::vector<gfdm_complex> in = random_vector(n_frames * K * M);
+
+      std::vector<gfdm_complex> ref(in.size());
+      modulator_kernel_cc kernel(M, K, L, taps);
+      for(int f = 0; f < n_frames; f++){
+        kernel.generic_work(&ref[f * K * M], &in[f * K * M]);
+      }
+
+      // more threads than frames leaves some idle, chunks of 2 and 3 frames otherwise.
+      const int nthreads[] = {1, 3, 9};
+      for(size_t i = 0; i < sizeof(nthreads) / sizeof(int); i++){
+        batch_modulator batch(M, K, L, taps, nthreads[i]);
+        std::vector<gfdm_complex> res(in.size());
+        batch.modulate(&res[0], &in[0], n_frames);
+        golden::assert_close(ref, &res[0]);
+
+        res = in;
+        batch.modulate(&res[0], &res[0], n_frames);
+        golden::assert_close(ref, &res[0]);
+      }
+    }
+
+    void
+    qa_batch_kernels::t2_receiver_matches_kernel()
+    {
+      const int K = 16, M = 5, fft_len = 96, n_frames = 5;
+      const float a = 1.0f / std::sqrt(2.0f);
+      std::vector<gfdm_complex> points;
+      points.push_back(gfdm_complex(a, a));
+      points.push_back(gfdm_complex(-a, a));
+      points.push_back(gfdm_complex(-a, -a));
+      points.push_back(gfdm_complex(a, -a));
+      const std::vector<gfdm_complex> in = random_vector(n_frames * fft_len);
+
+      for(int ic_iter = 0; ic_iter <= 2; ic_iter += 2){
+        std::vector<gfdm_complex> ref(n_frames * K * M);
+        kernel::gfdm_receiver kernel(K, M, 0.35, fft_len);
+        for(int f = 0; f < n_frames; f++){
+          kernel.gfdm_work_ic(&ref[f * K * M], &in[f * fft_len], ic_iter, points);
+        }
+
+        batch_receiver batch(K, M, 0.35, fft_len, 2);
+        std::vector<gfdm_complex> res(ref.size());
+        batch.demodulate_ic(&res[0], &in[0], n_frames, ic_iter, points);
+        golden::assert_close(ref, &res[0]);
+      }
+
+      // frames of different length can not share a buffer.
+      batch_receiver batch(K, M, 0.35, fft_len, 2);
+      std::vector<gfdm_complex> buf = in;
+      CPPUNIT_ASSERT_THROW(batch.demodulate(&buf[0], &buf[0], n_frames), std::invalid_argument);
+    }
+
+  } /* namespace gfdm */
+} /* namespace gr */
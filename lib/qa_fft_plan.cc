@@ -0,0 +1,127 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2016 Andrej Rode.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "qa_fft_plan.h"
+#include "qa_golden.h"
+#include <gfdm/fft_plan.h>
+#include <volk/volk.h>
+#include <cmath>
+#include <cstdlib>
+
+namespace gr {
+  namespace gfdm {
+
+    namespace {
+      typedef golden::gfdm_complex gfdm_complex;
+
+      std::vector<gfdm_complex>
+      naive_dft(const gfdm_complex* in, int n, int sign)
+      {
+        std::vector<gfdm_complex> out(n);
+        for(int k = 0; k < n; k++){
+          std::complex<double> acc = 0.0;
+          for(int i = 0; i < n; i++){
+            acc += std::complex<double>(in[i]) * std::polar(1.0, sign * 2.0 * M_PI * double(i) * double(k) / double(n));
+          }
+          out[k] = gfdm_complex(acc);
+        }
+        return out;
+      }
+
+      void
+      fill_random(gfdm_complex* buf, int n)
+      {
+        for(int i = 0; i < n; i++){
+          buf[i] = gfdm_complex(float(std::rand()) / RAND_MAX - 0.5f, float(std::rand()) / RAND_MAX - 0.5f);
+        }
+      }
+    }
+
+    void
+    qa_fft_plan::t1_upgrade_keeps_result()
+    {
+      const int fft_len = 96;
+      gfdm_complex* in = (gfdm_complex*) volk_malloc(sizeof(gfdm_complex) * fft_len, volk_get_alignment());
+      gfdm_complex* out = (gfdm_complex*) volk_malloc(sizeof(gfdm_complex) * fft_len, volk_get_alignment());
+      fft_plan plan(fft_len, in, out, true);
+
+      // runs on whatever plan is current, the buffers MUST survive background planning.
+      fill_random(in, fft_len);
+      const std::vector<gfdm_complex> data(in, in + fft_len);
+      std::vector<gfdm_complex> ref = naive_dft(in, fft_len, -1);
+      plan.execute();
+      golden::assert_close(ref, out);
+
+      fft_plan::wait_for_upgrades();
+      CPPUNIT_ASSERT(plan.upgraded() || fft_plan::upgrade_effort() == FFTW_ESTIMATE);
+      golden::assert_close(data, in);
+      plan.execute();
+      golden::assert_close(ref, out);
+
+      volk_free(in);
+      volk_free(out);
+    }
+
+    void
+    qa_fft_plan::t2_in_place_backward()
+    {
+      const int fft_len = 64;
+      gfdm_complex* buf = (gfdm_complex*) volk_malloc(sizeof(gfdm_complex) * fft_len, volk_get_alignment());
+      fft_plan plan(fft_len, buf, buf, false);
+      fft_plan::wait_for_upgrades();
+
+      fill_random(buf, fft_len);
+      std::vector<gfdm_complex> ref = naive_dft(buf, fft_len, 1);
+      plan.execute();
+      golden::assert_close(ref, buf);
+      volk_free(buf);
+    }
+
+    void
+    qa_fft_plan::t3_threads_above_min_len()
+    {
+      const int threads = fft_plan::threads();
+      const int min_len = fft_plan::threads_min_len();
+      fft_plan::set_threads_min_len(128);
+      fft_plan::set_threads(2);
+      const int expected = fft_plan::threads();  // stays 1 without threaded FFTW
+      CPPUNIT_ASSERT_EQUAL(1, fft_plan::threads_for(127));
+      CPPUNIT_ASSERT_EQUAL(expected, fft_plan::threads_for(128));
+
+      const int fft_len = 256;
+      gfdm_complex* in = (gfdm_complex*) volk_malloc(sizeof(gfdm_complex) * fft_len, volk_get_alignment());
+      gfdm_complex* out = (gfdm_complex*) volk_malloc(sizeof(gfdm_complex) * fft_len, volk_get_alignment());
+      fft_plan plan(fft_len, in, out, true);
+      fft_plan::set_threads(threads);
+      fft_plan::set_threads_min_len(min_len);
+      CPPUNIT_ASSERT_EQUAL(expected, plan.nthreads());
+
+      fft_plan::wait_for_upgrades();
+      fill_random(in, fft_len);
+      std::vector<gfdm_complex> ref = naive_dft(in, fft_len, -1);
+      plan.execute();
+      golden::assert_close(ref, out);
+      volk_free(in);
+      volk_free(out);
+    }
+
+  } /* namespace gfdm */
+} /* namespace gr */
+
@@ -26,11 +26,45 @@
  */
 
 #include "qa_gfdm.h"
+#include "qa_modulator_kernel_cc.h"
+#include "qa_add_cyclic_prefix_cc.h"
+#include "qa_preamble_correlator_cc.h"
+#include "qa_nco_cc.h"
+#include "qa_fft_plan.h"
+#include "qa_simd_kernels.h"
+#include "qa_gfdm_utils.h"
+#include "qa_batch_kernels.h"
+#include "qa_sync_kernel_cc.h"
+#include "qa_gfdm_receiver.h"
+#include "qa_tracer.h"
+#include "qa_work_stealing_pool.h"
+#include "qa_kernel_perf.h"
 
 CppUnit::TestSuite *
 qa_gfdm::suite()
 {
   CppUnit::TestSuite *s = new CppUnit::TestSuite("gfdm");
+  s->addTest(gr::gfdm::qa_modulator_kernel_cc::suite());
+  s->addTest(gr::gfdm::qa_add_cyclic_prefix_cc::suite());
+  s->addTest(gr::gfdm::qa_preamble_correlator_cc::suite());
+  s->addTest(gr::gfdm::qa_nco_cc::suite());
+  s->addTest(gr::gfdm::qa_fft_plan::suite());
+  s->addTest(gr::gfdm::qa_simd_kernels::suite());
+  s->addTest(gr::gfdm::qa_gfdm_utils::suite());
+  s->addTest(gr::gfdm::qa_batch_kernels::suite());
+  s->addTest(gr::gfdm::qa_sync_kernel_cc::suite());
+  s->addTest(gr::gfdm::qa_gfdm_receiver::suite());
+  s->addTest(gr::gfdm::qa_tracer::suite());
+  s->addTest(gr::gfdm::qa_work_stealing_pool::suite());
+
+  return s;
+}
+
+CppUnit::TestSuite *
+qa_gfdm::perf_suite()
+{
+  CppUnit::TestSuite *s = new CppUnit::TestSuite("gfdm_perf");
+  s->addTest(gr::gfdm::qa_kernel_perf::suite());
 
   return s;
 }
@@ -33,6 +33,8 @@ class __GR_ATTR_EXPORT qa_gfdm
  public:
   //! return suite of tests for all of gr-filter directory
   static CppUnit::TestSuite *suite();
+  //! kernel timing regression tests, configure qa_kernel_perf first
+  static CppUnit::TestSuite *perf_suite();
 };
 
 #endif /* _QA_GFDM_H_ */
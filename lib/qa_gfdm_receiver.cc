@@ -0,0 +1,83 @@
+/* -*- c++ -*- */
+/* 
+ * Copyright 2016 Andrej Rode.
+ * 
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ * 
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "qa_gfdm_receiver.h"
+#include "qa_golden.h"
+#include <gfdm/gfdm_receiver.h>
+
+namespace gr {
+  namespace gfdm {
+
+    //! ic_iter 0 checks gfdm_work, otherwise gfdm_work_ic with QPSK decisions.
+    static void
+    check_receiver(double alpha, int M, int K, int ic_iter)
+    {
+      std::stringstream name;
+      name << "receiver_M" << M << "_K" << K;
+      std::vector<golden::gfdm_complex> in = golden::read_cfile(name.str() + "_in");
+      std::stringstream suffix;
+      if(ic_iter > 0){
+        suffix << "_sic" << ic_iter;
+      }
+      std::vector<golden::gfdm_complex> ref = golden::read_cfile(name.str() + suffix.str() + "_out");
+
+      kernel::gfdm_receiver receiver(K, M, alpha, M * K);
+      CPPUNIT_ASSERT_EQUAL(M * K, int(in.size()));
+      std::vector<golden::gfdm_complex> res(M * K);
+      if(ic_iter > 0){
+        std::vector<golden::gfdm_complex> qpsk;
+        qpsk.push_back(golden::gfdm_complex(-1, -1));
+        qpsk.push_back(golden::gfdm_complex(-1, 1));
+        qpsk.push_back(golden::gfdm_complex(1, -1));
+        qpsk.push_back(golden::gfdm_complex(1, 1));
+        receiver.gfdm_work_ic(&res[0], &in[0], ic_iter, qpsk);
+      }
+      else{
+        receiver.gfdm_work(&res[0], &in[0], M * K, M * K);
+      }
+      golden::assert_close(ref, &res[0]);
+    }
+
+    void
+    qa_gfdm_receiver::t1_golden_M16_K16()
+    {
+      check_receiver(.2, 16, 16, 0);
+    }
+
+    void
+    qa_gfdm_receiver::t2_golden_M8_K32()
+    {
+      check_receiver(.5, 8, 32, 0);
+    }
+
+    void
+    qa_gfdm_receiver::t3_golden_sic_M16_K16()
+    {
+      check_receiver(.2, 16, 16, 2);
+    }
+
+    void
+    qa_gfdm_receiver::t4_golden_sic_M8_K32()
+    {
+      check_receiver(.5, 8, 32, 2);
+    }
+
+  } /* namespace gfdm */
+} /* namespace gr */
@@ -0,0 +1,51 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2016 Andrej Rode.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "qa_gfdm_utils.h"
+#include <gfdm/gfdm_utils.h>
+#include <cmath>
+
+namespace gr {
+  namespace gfdm {
+
+    void
+    qa_gfdm_utils::t1_root_raised_cosine()
+    {
+      // alpha 0.25 and 4 samples per symbol hit the x = T/(4 alpha) special case at +-4.
+      const std::vector<float> taps = root_raised_cosine(2.0, 1.0, 0.25, 0.25, 64);
+      CPPUNIT_ASSERT_EQUAL(size_t(65), taps.size());
+
+      float sum = 0.0f;
+      for(size_t i = 0; i < taps.size(); i++){
+        CPPUNIT_ASSERT(std::isfinite(taps[i]));
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(taps[i], taps[taps.size() - 1 - i], 1e-6);
+        sum += taps[i];
+      }
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(2.0, sum, 1e-4);
+
+      // the main lobe peaks in the center.
+      const int center = taps.size() / 2;
+      for(size_t i = 0; i < taps.size(); i++){
+        CPPUNIT_ASSERT(taps[i] <= taps[center]);
+      }
+    }
+
+  } /* namespace gfdm */
+} /* namespace gr */
@@ -0,0 +1,84 @@
+/* -*- c++ -*- */
+/* 
+ * Copyright 2016 Andrej Rode.
+ * 
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ * 
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef _QA_GOLDEN_H_
+#define _QA_GOLDEN_H_
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <complex>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <cmath>
+
+// golden vectors are generated by lib/golden/generate_golden_vectors.py
+#ifndef GFDM_GOLDEN_DIR
+#define GFDM_GOLDEN_DIR "golden"
+#endif
+
+namespace gr {
+  namespace gfdm {
+    namespace golden {
+
+      typedef std::complex<float> gfdm_complex;
+
+      //! Read a golden vector stored as interleaved float32 (.cfile).
+      inline std::vector<gfdm_complex>
+      read_cfile(const std::string& name)
+      {
+        const std::string filename = std::string(GFDM_GOLDEN_DIR) + "/" + name + ".cfile";
+        std::ifstream f(filename.c_str(), std::ios::binary | std::ios::ate);
+        if(!f){
+          CPPUNIT_FAIL("cannot open golden vector " + filename);
+        }
+        std::vector<gfdm_complex> v(f.tellg() / sizeof(gfdm_complex));
+        f.seekg(0);
+        f.read(reinterpret_cast<char*>(&v[0]), v.size() * sizeof(gfdm_complex));
+        return v;
+      }
+
+      //! max |res - ref| MUST stay below rel_tol * max |ref|.
+      inline void
+      assert_close(const std::vector<gfdm_complex>& ref, const gfdm_complex* res, float rel_tol = 1e-4f)
+      {
+        float ref_max = 0.0f;
+        float err_max = 0.0f;
+        size_t err_pos = 0;
+        for(size_t i = 0; i < ref.size(); i++){
+          ref_max = std::max(ref_max, std::abs(ref[i]));
+          const float err = std::abs(ref[i] - res[i]);
+          if(err > err_max){
+            err_max = err;
+            err_pos = i;
+          }
+        }
+        std::stringstream msg;
+        msg << "max error " << err_max << " at " << err_pos << " exceeds " << rel_tol << " * " << ref_max;
+        CPPUNIT_ASSERT_MESSAGE(msg.str(), err_max <= rel_tol * ref_max);
+      }
+
+    } /* namespace golden */
+  } /* namespace gfdm */
+} /* namespace gr */
+
+#endif /* _QA_GOLDEN_H_ */
@@ -0,0 +1,134 @@
+/* -*- c++ -*- */
+/* 
+ * Copyright 2016 Andrej Rode.
+ * 
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ * 
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "qa_kernel_perf.h"
+#include "kernel_bench.h"
+#include <map>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+
+namespace gr {
+  namespace gfdm {
+
+    std::string qa_kernel_perf::s_baseline_file;
+    double qa_kernel_perf::s_tolerance = 0.25;
+    bool qa_kernel_perf::s_record = false;
+
+    void
+    qa_kernel_perf::configure(const std::string& baseline_file, double tolerance, bool record)
+    {
+      s_baseline_file = baseline_file;
+      s_tolerance = tolerance;
+      s_record = record;
+    }
+
+    //! Baseline lines are "<case_id> <ns_per_frame>", '#' starts a comment.
+    static std::map<std::string, double>
+    read_baseline(const std::string& filename)
+    {
+      std::map<std::string, double> baseline;
+      std::ifstream f(filename.c_str());
+      if(!f){
+        CPPUNIT_FAIL("cannot open performance baseline " + filename);
+      }
+      std::string line;
+      while(std::getline(f, line)){
+        line = line.substr(0, line.find('#'));
+        std::stringstream ss(line);
+        std::string id;
+        double ns;
+        if(ss >> id >> ns){
+          baseline[id] = ns;
+        }
+      }
+      return baseline;
+    }
+
+    //! Best of several short runs, the minimum is the most stable estimate on a busy machine.
+    static double
+    measure(bench::bench_case& c)
+    {
+      double best = 0.0;
+      for(int i = 0; i < 5; i++){
+        long n_runs;
+        const double ns = bench::time_case(c, 0.05, n_runs);
+        best = (i == 0) ? ns : std::min(best, ns);
+      }
+      return best;
+    }
+
+    void
+    qa_kernel_perf::t1_compare_baseline()
+    {
+      CPPUNIT_ASSERT_MESSAGE("no performance baseline file configured", !s_baseline_file.empty());
+
+      std::srand(42);
+      bench::params_t p = {64, 15, 2, 64 * 15};
+      std::vector<bench::named_case_t> cases = bench::make_cases(p, std::vector<int>(1, 2 * p.K));
+
+      std::map<std::string, double> baseline;
+      if(!s_record){
+        baseline = read_baseline(s_baseline_file);
+      }
+
+      std::stringstream record;
+      record << "# gr-gfdm kernel timings in ns/frame, written by test-gfdm --perf-record\n";
+      std::stringstream failures;
+      std::stringstream missing;
+      int n_failed = 0;
+      int n_missing = 0;
+      for(size_t i = 0; i < cases.size(); i++){
+        const std::string id = bench::case_id(cases[i]);
+        const double ns = measure(*cases[i].bench);
+        record << id << " " << ns << "\n";
+        if(s_record){
+          continue;
+        }
+
+        std::map<std::string, double>::const_iterator it = baseline.find(id);
+        if(it == baseline.end()){
+          std::cout << "perf: " << id << " " << ns << " ns/frame, no baseline" << std::endl;
+          missing << "\n  " << id;
+          n_missing++;
+          continue;
+        }
+        const double ratio = ns / it->second;
+        std::cout << "perf: " << id << " " << ns << " ns/frame, " << ratio << " x baseline" << std::endl;
+        if(ratio > 1.0 + s_tolerance){
+          failures << "\n  " << id << ": " << ns << " ns/frame vs baseline " << it->second;
+          n_failed++;
+        }
+      }
+
+      if(s_record){
+        std::ofstream f(s_baseline_file.c_str());
+        CPPUNIT_ASSERT_MESSAGE("cannot write performance baseline " + s_baseline_file, f.good());
+        f << record.str();
+        return;
+      }
+      // an unchecked case is no regression test, record the baseline first
+      CPPUNIT_ASSERT_MESSAGE("cases without baseline in " + s_baseline_file + ", run test-gfdm --perf-record:"
+                             + missing.str(), n_missing == 0);
+      CPPUNIT_ASSERT_MESSAGE("kernels slower than baseline:" + failures.str(), n_failed == 0);
+    }
+
+  } /* namespace gfdm */
+} /* namespace gr */
@@ -0,0 +1,58 @@
+/* -*- c++ -*- */
+/* 
+ * Copyright 2016 Andrej Rode.
+ * 
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ * 
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef _QA_KERNEL_PERF_H_
+#define _QA_KERNEL_PERF_H_
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestCase.h>
+#include <string>
+
+namespace gr {
+  namespace gfdm {
+
+    /*!
+     * Kernel timing regression test. Compares ns/frame of the kernel_bench.h
+     * cases against a per-machine-class baseline file and fails if any kernel
+     * is slower than baseline * (1 + tolerance). Not part of the default suite.
+     */
+    class qa_kernel_perf : public CppUnit::TestCase
+    {
+    public:
+      CPPUNIT_TEST_SUITE(qa_kernel_perf);
+      CPPUNIT_TEST(t1_compare_baseline);
+      CPPUNIT_TEST_SUITE_END();
+
+    public:
+      //! With record set, the baseline file is rewritten from this machine's timings instead.
+      static void configure(const std::string& baseline_file, double tolerance, bool record);
+
+    private:
+      static std::string s_baseline_file;
+      static double s_tolerance;
+      static bool s_record;
+
+      void t1_compare_baseline();
+    };
+
+  } /* namespace gfdm */
+} /* namespace gr */
+
+#endif /* _QA_KERNEL_PERF_H_ */
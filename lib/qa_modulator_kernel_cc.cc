@@ -0,0 +1,63 @@
+/* -*- c++ -*- */
+/* 
+ * Copyright 2016 Andrej Rode.
+ * 
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ * 
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "qa_modulator_kernel_cc.h"
+#include "qa_golden.h"
+#include <gfdm/modulator_kernel_cc.h>
+
+namespace gr {
+  namespace gfdm {
+
+    static void
+    check_modulator(int M, int K, int L)
+    {
+      std::stringstream name;
+      name << "modulator_M" << M << "_K" << K << "_L" << L;
+      std::vector<golden::gfdm_complex> taps = golden::read_cfile(name.str() + "_taps");
+      std::vector<golden::gfdm_complex> in = golden::read_cfile(name.str() + "_in");
+      std::vector<golden::gfdm_complex> ref = golden::read_cfile(name.str() + "_out");
+
+      modulator_kernel_cc kernel(M, K, L, taps);
+      CPPUNIT_ASSERT_EQUAL(int(in.size()), kernel.block_size());
+      std::vector<golden::gfdm_complex> res(kernel.block_size());
+      kernel.generic_work(&res[0], &in[0]);
+      golden::assert_close(ref, &res[0]);
+    }
+
+    void
+    qa_modulator_kernel_cc::t1_golden_M8_K4_L2()
+    {
+      check_modulator(8, 4, 2);
+    }
+
+    void
+    qa_modulator_kernel_cc::t2_golden_M15_K16_L2()
+    {
+      check_modulator(15, 16, 2);
+    }
+
+    void
+    qa_modulator_kernel_cc::t3_golden_M9_K8_L4()
+    {
+      check_modulator(9, 8, 4);
+    }
+
+  } /* namespace gfdm */
+} /* namespace gr */
@@ -0,0 +1,48 @@
+/* -*- c++ -*- */
+/* 
+ * Copyright 2016 Andrej Rode.
+ * 
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ * 
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef _QA_MODULATOR_KERNEL_CC_H_
+#define _QA_MODULATOR_KERNEL_CC_H_
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestCase.h>
+
+namespace gr {
+  namespace gfdm {
+
+    class qa_modulator_kernel_cc : public CppUnit::TestCase
+    {
+    public:
+      CPPUNIT_TEST_SUITE(qa_modulator_kernel_cc);
+      CPPUNIT_TEST(t1_golden_M8_K4_L2);
+      CPPUNIT_TEST(t2_golden_M15_K16_L2);
+      CPPUNIT_TEST(t3_golden_M9_K8_L4);
+      CPPUNIT_TEST_SUITE_END();
+
+    private:
+      void t1_golden_M8_K4_L2();
+      void t2_golden_M15_K16_L2();
+      void t3_golden_M9_K8_L4();
+    };
+
+  } /* namespace gfdm */
+} /* namespace gr */
+
+#endif /* _QA_MODULATOR_KERNEL_CC_H_ */
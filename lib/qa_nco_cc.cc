@@ -0,0 +1,46 @@
+/* -*- c++ -*- */
+/* 
+ * Copyright 2016 Andrej Rode.
+ * 
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ * 
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "qa_nco_cc.h"
+#include "qa_golden.h"
+#include <gfdm/nco_cc.h>
+
+namespace gr {
+  namespace gfdm {
+
+    void
+    qa_nco_cc::t1_golden_phase_continuous()
+    {
+      std::vector<golden::gfdm_complex> in = golden::read_cfile("nco_F1000_in");
+      std::vector<golden::gfdm_complex> ref = golden::read_cfile("nco_F1000_out");
+
+      // rotate in uneven chunks, the phase MUST carry over between calls.
+      nco_cc nco(0.0123);
+      std::vector<golden::gfdm_complex> res(in.size());
+      const int chunk_len = 333;
+      for(size_t pos = 0; pos < in.size(); pos += chunk_len){
+        const int n = std::min(chunk_len, int(in.size() - pos));
+        nco.rotate(&res[pos], &in[pos], n);
+      }
+      golden::assert_close(ref, &res[0], 1e-3f);
+    }
+
+  } /* namespace gfdm */
+} /* namespace gr */
@@ -0,0 +1,66 @@
+/* -*- c++ -*- */
+/* 
+ * Copyright 2016 Andrej Rode.
+ * 
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ * 
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "qa_preamble_correlator_cc.h"
+#include "qa_golden.h"
+#include <gfdm/preamble_correlator_cc.h>
+
+namespace gr {
+  namespace gfdm {
+
+    static const int preamble_len = 32;
+    static const int n_lags = 100;
+
+    void
+    qa_preamble_correlator_cc::t1_golden_overlap_save()
+    {
+      // fft_len 64 needs several overlap-save hops for 100 lags.
+      std::vector<golden::gfdm_complex> spectrum = golden::read_cfile("preamble_correlator_P32_N64_spectrum");
+      std::vector<golden::gfdm_complex> in = golden::read_cfile("preamble_correlator_P32_N64_in");
+      std::vector<golden::gfdm_complex> ref = golden::read_cfile("preamble_correlator_P32_N64_out");
+
+      preamble_correlator_cc kernel(preamble_len, spectrum);
+      std::vector<golden::gfdm_complex> res(n_lags);
+      kernel.generic_work(&res[0], &in[0], n_lags);
+      golden::assert_close(ref, &res[0]);
+    }
+
+    void
+    qa_preamble_correlator_cc::t2_golden_chunked()
+    {
+      // results MUST NOT depend on how lags are split across calls.
+      std::vector<golden::gfdm_complex> spectrum = golden::read_cfile("preamble_correlator_P32_N64_spectrum");
+      std::vector<golden::gfdm_complex> in = golden::read_cfile("preamble_correlator_P32_N64_in");
+      std::vector<golden::gfdm_complex> ref = golden::read_cfile("preamble_correlator_P32_N64_out");
+
+      preamble_correlator_cc kernel(preamble_len, spectrum);
+      std::vector<golden::gfdm_complex> res(n_lags);
+      const int chunks[] = {1, 17, 33, 49};
+      int pos = 0;
+      for(int i = 0; i < 4; i++){
+        kernel.generic_work(&res[pos], &in[pos], chunks[i]);
+        pos += chunks[i];
+      }
+      CPPUNIT_ASSERT_EQUAL(n_lags, pos);
+      golden::assert_close(ref, &res[0]);
+    }
+
+  } /* namespace gfdm */
+} /* namespace gr */
@@ -0,0 +1,100 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2016 Andrej Rode.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "qa_simd_kernels.h"
+#include "qa_golden.h"
+#include <gfdm/simd_kernels.h>
+#include <cstdlib>
+
+namespace gr {
+  namespace gfdm {
+
+    namespace {
+      typedef golden::gfdm_complex gfdm_complex;
+
+      std::vector<gfdm_complex>
+      random_vector(int n)
+      {
+        std::vector<gfdm_complex> v(n);
+        for(int i = 0; i < n; i++){
+          v[i] = gfdm_complex(float(std::rand()) / RAND_MAX - 0.5f, float(std::rand()) / RAND_MAX - 0.5f);
+        }
+        return v;
+      }
+    }
+
+    void
+    qa_simd_kernels::t1_multiply_circular_add()
+    {
+      const std::vector<std::string> impls = simd::available_impls();
+      CPPUNIT_ASSERT_EQUAL(std::string("generic"), impls[0]);
+      // odd lengths leave a tail after every vector width, offsets force wraps.
+      const int lens[] = {1, 7, 15, 33};
+      const int target_len = 40;
+      for(size_t i = 0; i < sizeof(lens) / sizeof(int); i++){
+        const int n = lens[i];
+        const std::vector<gfdm_complex> in = random_vector(n);
+        const std::vector<gfdm_complex> taps = random_vector(n);
+        const std::vector<gfdm_complex> target = random_vector(target_len);
+        for(int offset = 0; offset < target_len; offset += 13){
+          std::vector<gfdm_complex> ref = target;
+          for(int j = 0; j < n; j++){
+            ref[(offset + j) % target_len] += in[j] * taps[j];
+          }
+          for(size_t a = 0; a < impls.size(); a++){
+            std::vector<gfdm_complex> res = target;
+            simd::multiply_circular_add_manual(impls[a], &res[0], target_len, offset, &in[0], &taps[0], n);
+            golden::assert_close(ref, &res[0]);
+          }
+        }
+      }
+    }
+
+    void
+    qa_simd_kernels::t2_gather_multiply_fold()
+    {
+      const std::vector<std::string> impls = simd::available_impls();
+      const int lens[] = {1, 9, 16, 21};
+      const int in_len = 50;
+      const std::vector<gfdm_complex> in = random_vector(in_len);
+      for(size_t i = 0; i < sizeof(lens) / sizeof(int); i++){
+        const int n = lens[i];
+        for(int fold = 1; fold <= 3; fold++){
+          const std::vector<gfdm_complex> taps = random_vector(n * fold);
+          for(int offset = 0; offset < in_len; offset += 17){
+            std::vector<gfdm_complex> ref(n);
+            for(int m = 0; m < n; m++){
+              for(int l = 0; l < fold; l++){
+                ref[m] += in[(offset + l * n + m) % in_len] * taps[l * n + m];
+              }
+            }
+            for(size_t a = 0; a < impls.size(); a++){
+              std::vector<gfdm_complex> res(n);
+              simd::gather_multiply_fold_manual(impls[a], &res[0], &in[0], in_len, offset, &taps[0], n, fold);
+              golden::assert_close(ref, &res[0]);
+            }
+          }
+        }
+      }
+      CPPUNIT_ASSERT_THROW(simd::select_impl(simd::GATHER_MULTIPLY_FOLD, "no_such_arch"), std::invalid_argument);
+    }
+
+  } /* namespace gfdm */
+} /* namespace gr */
@@ -0,0 +1,114 @@
+/* -*- c++ -*- */
+/* 
+ * Copyright 2016 Andrej Rode.
+ * 
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ * 
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "qa_sync_kernel_cc.h"
+#include "qa_golden.h"
+#include <gfdm/sync_kernel_cc.h>
+#include <cstdlib>
+
+namespace gr {
+  namespace gfdm {
+
+    static std::vector<golden::gfdm_complex>
+    random_samples(int n)
+    {
+      std::srand(42);
+      std::vector<golden::gfdm_complex> v(n);
+      for(int i = 0; i < n; i++){
+        v[i] = golden::gfdm_complex(std::rand() / float(RAND_MAX) - 0.5f, std::rand() / float(RAND_MAX) - 0.5f);
+      }
+      return v;
+    }
+
+    void
+    qa_sync_kernel_cc::t1_autocorrelate()
+    {
+      const int sync_fft_len = 64;
+      const int L = sync_fft_len / 2;
+      const int num_items = 1000;
+      sync_kernel_cc kernel(preamble_generator_sptr(new preamble_generator(32, 0.5, sync_fft_len)), 352);
+      std::vector<golden::gfdm_complex> in = random_samples(num_items + 2 * L - 1);
+
+      std::vector<golden::gfdm_complex> ref(num_items);
+      for(int i = 0; i < num_items; i++){
+        for(int n = 0; n < L; n++){
+          ref[i] += std::conj(in[i + n]) * in[i + n + L];
+        }
+        ref[i] /= float(L);
+      }
+      std::vector<golden::gfdm_complex> res(num_items);
+      kernel.autocorrelate(&res[0], &in[0], num_items);
+      golden::assert_close(ref, &res[0], 1e-4f);
+    }
+
+    void
+    qa_sync_kernel_cc::t2_correlate_window()
+    {
+      const int sync_fft_len = 64;
+      preamble_generator_sptr generator(new preamble_generator(32, 0.5, sync_fft_len));
+      const std::vector<golden::gfdm_complex> preamble = generator->get_preamble();
+      sync_kernel_cc kernel(generator, 352);
+      std::vector<golden::gfdm_complex> in = random_samples(352 + sync_fft_len - 1);
+
+      // a short track window takes the direct path, a full block overlap-save
+      const int n_lags[] = {17, 352};
+      for(int k = 0; k < 2; k++){
+        std::vector<golden::gfdm_complex> ref(n_lags[k]);
+        for(int i = 0; i < n_lags[k]; i++){
+          for(int n = 0; n < sync_fft_len; n++){
+            ref[i] += std::conj(preamble[n]) * in[i + n];
+          }
+          ref[i] /= float(sync_fft_len);
+        }
+        std::vector<golden::gfdm_complex> res(n_lags[k]);
+        kernel.correlate_window(&res[0], &in[0], n_lags[k]);
+        golden::assert_close(ref, &res[0], 1e-4f);
+      }
+    }
+
+    void
+    qa_sync_kernel_cc::t3_autocorrelate_long_run()
+    {
+      // the running sum MUST NOT drift away from the direct dot product over a long call
+      // with a strong DC offset and a partial last block.
+      const int sync_fft_len = 64;
+      const int L = sync_fft_len / 2;
+      const int num_items = (1 << 20) + 77;
+      sync_kernel_cc kernel(preamble_generator_sptr(new preamble_generator(32, 0.5, sync_fft_len)), 352);
+      std::vector<golden::gfdm_complex> in = random_samples(num_items + 2 * L - 1);
+      for(size_t i = 0; i < in.size(); i++){
+        in[i] += golden::gfdm_complex(10.0f, -10.0f);
+      }
+      std::vector<golden::gfdm_complex> res(num_items);
+      kernel.autocorrelate(&res[0], &in[0], num_items);
+
+      std::vector<golden::gfdm_complex> ref(num_items);
+      for(int i = 0; i < num_items; i++){
+        std::complex<double> acc = 0.0;
+        for(int n = 0; n < L; n++){
+          acc += std::conj(std::complex<double>(in[i + n])) * std::complex<double>(in[i + n + L]);
+        }
+        ref[i] = golden::gfdm_complex(acc / double(L));
+      }
+      golden::assert_close(ref, &res[0], 1e-5f);
+    }
+
+  } /* namespace gfdm */
+} /* namespace gr */
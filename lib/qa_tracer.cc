@@ -0,0 +1,181 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2016 Andrej Rode.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "qa_tracer.h"
+#include <gfdm/tracer.h>
+#include <boost/thread/thread.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/json_parser.hpp>
+
+namespace gr {
+  namespace gfdm {
+
+    namespace {
+      struct traced_event
+      {
+        std::string name;
+        double ts;
+        double dur;
+        int64_t frames;
+      };
+
+      //! Complete ("X") events named name from a dump, in file order. Fails if the JSON doesn't parse.
+      std::vector<traced_event>
+      read_trace(const std::string& filename, const std::string& name)
+      {
+        boost::property_tree::ptree trace;
+        try{
+          boost::property_tree::read_json(filename, trace);
+        }
+        catch(const boost::property_tree::json_parser_error& e){
+          CPPUNIT_FAIL(std::string("trace is no valid JSON: ") + e.what());
+        }
+        std::vector<traced_event> events;
+        const boost::property_tree::ptree& trace_events = trace.get_child("traceEvents");
+        for(boost::property_tree::ptree::const_iterator it = trace_events.begin(); it != trace_events.end(); ++it){
+          const boost::property_tree::ptree& event = it->second;
+          if(event.get<std::string>("ph") != "X" || event.get<std::string>("name") != name){
+            continue;
+          }
+          traced_event e;
+          e.name = name;
+          e.ts = event.get<double>("ts");
+          e.dur = event.get<double>("dur");
+          e.frames = event.get<int64_t>("args.frames", -1);
+          events.push_back(e);
+        }
+        return events;
+      }
+
+      std::string
+      trace_filename()
+      {
+        return (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("qa_tracer_%%%%%%%%.json")).string();
+      }
+
+      //! Event i spans [i, i + 1] us and carries i as frame count, a torn slot breaks that pattern.
+      void
+      check_sequence(const std::vector<traced_event>& events, int64_t first)
+      {
+        for(size_t i = 0; i < events.size(); i++){
+          CPPUNIT_ASSERT_EQUAL(first + int64_t(i), events[i].frames);
+          CPPUNIT_ASSERT_DOUBLES_EQUAL(double(events[i].frames), events[i].ts, 1e-3);
+          CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, events[i].dur, 1e-3);
+        }
+      }
+
+      struct event_writer
+      {
+        const char* name;
+        int64_t n_events;
+        boost::atomic<bool>* stop;
+
+        void operator()() const
+        {
+          for(int64_t i = 0; i < n_events || (stop && !stop->load()); i++){
+            tracer::record(name, double(i), double(i + 1), i);
+          }
+        }
+      };
+    }
+
+    void
+    qa_tracer::t1_wrap_around()
+    {
+      // new threads get rings of this size, both wrap around three times.
+      const int capacity = 64;
+      const int n_events = 3 * capacity + 11;
+      const char* const names[] = {"qa_tracer::writer_0", "qa_tracer::writer_1"};
+      tracer::enable(capacity);
+      tracer::clear();
+      boost::thread_group writers;
+      for(int w = 0; w < 2; w++){
+        event_writer writer = {names[w], n_events, 0};
+        writers.create_thread(writer);
+      }
+      writers.join_all();
+      tracer::disable();
+
+      const std::string filename = trace_filename();
+      CPPUNIT_ASSERT(tracer::dump(filename));
+      for(int w = 0; w < 2; w++){
+        // the newest capacity - 1 events survive, oldest first. The slot after
+        // them is the next one written and is never dumped.
+        std::vector<traced_event> events = read_trace(filename, names[w]);
+        CPPUNIT_ASSERT_EQUAL(size_t(capacity - 1), events.size());
+        check_sequence(events, n_events - capacity + 1);
+      }
+      boost::filesystem::remove(filename);
+    }
+
+    void
+    qa_tracer::t2_dump_while_recording()
+    {
+      // the writer laps the ring many times during each dump, lapped slots must be skipped.
+      const int capacity = 64;
+      const char* const name = "qa_tracer::lapping_writer";
+      boost::atomic<bool> stop(false);
+      tracer::enable(capacity);
+      event_writer writer = {name, 0, &stop};
+      boost::thread t(writer);
+
+      const std::string filename = trace_filename();
+      for(int i = 0; i < 50; i++){
+        CPPUNIT_ASSERT(tracer::dump(filename));
+        std::vector<traced_event> events = read_trace(filename, name);
+        CPPUNIT_ASSERT(events.size() < size_t(capacity));
+        if(!events.empty()){
+          check_sequence(events, events[0].frames);
+        }
+      }
+      stop.store(true);
+      t.join();
+      tracer::disable();
+      boost::filesystem::remove(filename);
+    }
+
+    void
+    qa_tracer::t3_clear()
+    {
+      const char* const name = "qa_tracer::clear";
+      tracer::enable();
+      for(int i = 0; i < 5; i++){
+        tracer::record(name, double(i), double(i + 1), i);
+      }
+      tracer::clear();
+      const std::string filename = trace_filename();
+      CPPUNIT_ASSERT(tracer::dump(filename));
+      CPPUNIT_ASSERT(read_trace(filename, name).empty());
+
+      // recording continues behind the cleared events
+      for(int i = 5; i < 8; i++){
+        tracer::record(name, double(i), double(i + 1), i);
+      }
+      tracer::disable();
+      CPPUNIT_ASSERT(tracer::dump(filename));
+      std::vector<traced_event> events = read_trace(filename, name);
+      CPPUNIT_ASSERT_EQUAL(size_t(3), events.size());
+      check_sequence(events, 5);
+      boost::filesystem::remove(filename);
+    }
+
+  } /* namespace gfdm */
+} /* namespace gr */
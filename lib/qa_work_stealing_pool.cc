@@ -0,0 +1,69 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2016 Andrej Rode.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "qa_work_stealing_pool.h"
+#include "work_stealing_pool.h"
+#include <boost/atomic.hpp>
+
+namespace gr {
+  namespace gfdm {
+
+    namespace {
+      //! Chains of tiny tasks, every task queues its successor on the worker it runs on.
+      struct chain_t
+      {
+        work_stealing_pool* pool;
+        boost::atomic<long>* started;
+        boost::atomic<long>* finished;
+
+        void run(int remaining, int worker) const
+        {
+          (*started)++;
+          if(remaining > 1){
+            pool->submit(boost::bind(&chain_t::run, *this, remaining - 1, _1), worker);
+          }
+          (*finished)++;
+        }
+      };
+    }
+
+    void
+    qa_work_stealing_pool::t1_resubmitting_tasks()
+    {
+      // Idle workers steal a successor as soon as it is queued. wait() MUST
+      // not return before every task, including the submitting one, is done.
+      const int n_chains = 64;
+      const int chain_len = 32;
+      work_stealing_pool pool(4);
+      for(int round = 0; round < 200; round++){
+        boost::atomic<long> started(0);
+        boost::atomic<long> finished(0);
+        chain_t chain = {&pool, &started, &finished};
+        for(int c = 0; c < n_chains; c++){
+          pool.submit(boost::bind(&chain_t::run, chain, chain_len, _1), c % pool.size());
+        }
+        pool.wait();
+        CPPUNIT_ASSERT_EQUAL(long(n_chains * chain_len), started.load());
+        CPPUNIT_ASSERT_EQUAL(long(n_chains * chain_len), finished.load());
+      }
+    }
+
+  } /* namespace gfdm */
+} /* namespace gr */
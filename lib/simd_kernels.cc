@@ -0,0 +1,274 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2016 Andrej Rode.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gfdm/simd_kernels.h>
+#include "simd_kernels_impl.h"
+#include <boost/atomic.hpp>
+#include <boost/thread/once.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace gr {
+  namespace gfdm {
+    namespace simd {
+
+      namespace {
+        void
+        multiply_add_generic(float* target, const float* in, const float* taps, int n)
+        {
+          multiply_add_scalar(target, in, taps, n);
+        }
+
+        void
+        multiply_fold_generic(float* out, const float* const* rows, const float* taps, int n, int fold, int taps_stride)
+        {
+          multiply_fold_scalar(out, rows, taps, 0, n, fold, taps_stride);
+        }
+
+        bool supports_generic(){ return true; }
+#if defined(GFDM_HAVE_SSE3) || defined(GFDM_HAVE_AVX2) || defined(GFDM_HAVE_AVX512)
+        // __builtin_cpu_supports also checks that the OS saves the wider registers.
+        bool supports_sse3(){ return __builtin_cpu_supports("sse3"); }
+        bool supports_avx2(){ return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"); }
+        bool supports_avx512(){ return __builtin_cpu_supports("avx512f"); }
+#endif
+
+        struct arch_t
+        {
+          const char* name;
+          bool (*supported)();
+          multiply_add_fn multiply_add;
+          multiply_fold_fn multiply_fold;
+        };
+
+        // ascending preference, the last supported one is the default.
+        const arch_t s_archs[] = {
+          {"generic", &supports_generic, &multiply_add_generic, &multiply_fold_generic},
+#ifdef GFDM_HAVE_SSE3
+          {"sse3", &supports_sse3, &multiply_add_sse3, &multiply_fold_sse3},
+#endif
+#ifdef GFDM_HAVE_AVX2
+          {"avx2", &supports_avx2, &multiply_add_avx2, &multiply_fold_avx2},
+#endif
+#ifdef GFDM_HAVE_AVX512
+          {"avx512", &supports_avx512, &multiply_add_avx512, &multiply_fold_avx512},
+#endif
+        };
+        const int s_n_archs = sizeof(s_archs) / sizeof(arch_t);
+
+        const char* const s_kernel_names[] = {"multiply_circular_add", "gather_multiply_fold"};
+
+        boost::once_flag s_init_once = BOOST_ONCE_INIT;
+        boost::atomic<int> s_selected[N_KERNELS];
+
+        int
+        find_arch(const std::string& impl)
+        {
+          for(int a = 0; a < s_n_archs; a++){
+            if(impl == s_archs[a].name && s_archs[a].supported()){
+              return a;
+            }
+          }
+          return -1;
+        }
+
+        // unknown kernels or implementations in the config are skipped, it may be from another build.
+        void
+        load_config()
+        {
+          std::ifstream f(config_filename().c_str());
+          std::string line;
+          while(std::getline(f, line)){
+            std::istringstream ss(line);
+            std::string kernel, impl;
+            if(!(ss >> kernel >> impl) || kernel[0] == '#'){
+              continue;
+            }
+            const int a = find_arch(impl);
+            for(int k = 0; k < N_KERNELS; k++){
+              if(kernel == s_kernel_names[k] && a >= 0){
+                s_selected[k].store(a);
+              }
+            }
+          }
+        }
+
+        void
+        init()
+        {
+#if defined(GFDM_HAVE_SSE3) || defined(GFDM_HAVE_AVX2) || defined(GFDM_HAVE_AVX512)
+          __builtin_cpu_init();
+#endif
+          int best = 0;
+          for(int a = 0; a < s_n_archs; a++){
+            if(s_archs[a].supported()){
+              best = a;
+            }
+          }
+          for(int k = 0; k < N_KERNELS; k++){
+            s_selected[k].store(best);
+          }
+          load_config();
+          // like the config, an implementation this CPU can't run is ignored.
+          const char* env = getenv("GFDM_SIMD_ARCH");
+          const int a = env ? find_arch(env) : -1;
+          if(a >= 0){
+            for(int k = 0; k < N_KERNELS; k++){
+              s_selected[k].store(a);
+            }
+          }
+        }
+
+        inline const arch_t&
+        selected(kernel_t kernel)
+        {
+          boost::call_once(s_init_once, &init);
+          return s_archs[s_selected[kernel].load(boost::memory_order_relaxed)];
+        }
+
+        const arch_t&
+        manual(const std::string& impl)
+        {
+          boost::call_once(s_init_once, &init);
+          const int a = find_arch(impl);
+          if(a < 0){
+            throw std::invalid_argument("simd: unknown or unsupported implementation " + impl);
+          }
+          return s_archs[a];
+        }
+
+        void
+        multiply_circular_add_impl(const arch_t& arch, gfdm_complex* target, int target_len, int target_offset,
+                                   const gfdm_complex* in, const gfdm_complex* taps, int n)
+        {
+          // at most ceil(n / target_len) + 1 contiguous runs, usually one or two.
+          int i = 0;
+          while(i < n){
+            const int pos = (target_offset + i) % target_len;
+            const int run = std::min(n - i, target_len - pos);
+            arch.multiply_add((float*) (target + pos), (const float*) (in + i), (const float*) (taps + i), run);
+            i += run;
+          }
+        }
+
+        void
+        gather_multiply_fold_impl(const arch_t& arch, gfdm_complex* out, const gfdm_complex* in, int in_len, int in_offset,
+                                  const gfdm_complex* taps, int n, int fold)
+        {
+          if(fold < 1 || fold > max_fold){
+            throw std::invalid_argument("gather_multiply_fold: fold MUST be in [1, max_fold]");
+          }
+          // split the output where any of the rows wraps around in_len.
+          const float* rows[max_fold];
+          int m = 0;
+          while(m < n){
+            int run = n - m;
+            for(int l = 0; l < fold; l++){
+              const int pos = (in_offset + l * n + m) % in_len;
+              rows[l] = (const float*) (in + pos);
+              run = std::min(run, in_len - pos);
+            }
+            arch.multiply_fold((float*) (out + m), rows, (const float*) (taps + m), run, fold, n);
+            m += run;
+          }
+        }
+      }
+
+      void
+      multiply_circular_add(gfdm_complex* target, int target_len, int target_offset,
+                            const gfdm_complex* in, const gfdm_complex* taps, int n)
+      {
+        multiply_circular_add_impl(selected(MULTIPLY_CIRCULAR_ADD), target, target_len, target_offset, in, taps, n);
+      }
+
+      void
+      gather_multiply_fold(gfdm_complex* out, const gfdm_complex* in, int in_len, int in_offset,
+                           const gfdm_complex* taps, int n, int fold)
+      {
+        gather_multiply_fold_impl(selected(GATHER_MULTIPLY_FOLD), out, in, in_len, in_offset, taps, n, fold);
+      }
+
+      void
+      multiply_circular_add_manual(const std::string& impl, gfdm_complex* target, int target_len, int target_offset,
+                                   const gfdm_complex* in, const gfdm_complex* taps, int n)
+      {
+        multiply_circular_add_impl(manual(impl), target, target_len, target_offset, in, taps, n);
+      }
+
+      void
+      gather_multiply_fold_manual(const std::string& impl, gfdm_complex* out, const gfdm_complex* in, int in_len,
+                                  int in_offset, const gfdm_complex* taps, int n, int fold)
+      {
+        gather_multiply_fold_impl(manual(impl), out, in, in_len, in_offset, taps, n, fold);
+      }
+
+      std::string
+      kernel_name(kernel_t kernel)
+      {
+        return s_kernel_names[kernel];
+      }
+
+      std::vector<std::string>
+      available_impls()
+      {
+        boost::call_once(s_init_once, &init);
+        std::vector<std::string> impls;
+        for(int a = 0; a < s_n_archs; a++){
+          if(s_archs[a].supported()){
+            impls.push_back(s_archs[a].name);
+          }
+        }
+        return impls;
+      }
+
+      void
+      select_impl(kernel_t kernel, const std::string& impl)
+      {
+        boost::call_once(s_init_once, &init);
+        const int a = find_arch(impl);
+        if(a < 0){
+          throw std::invalid_argument("simd: unknown or unsupported implementation " + impl);
+        }
+        s_selected[kernel].store(a);
+      }
+
+      std::string
+      selected_impl(kernel_t kernel)
+      {
+        return selected(kernel).name;
+      }
+
+      std::string
+      config_filename()
+      {
+        const char* home = getenv("HOME");
+        return std::string(home ? home : ".") + "/.gfdm/simd_config";
+      }
+
+    } /* namespace simd */
+  } /* namespace gfdm */
+} /* namespace gr */
@@ -0,0 +1,72 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2016 Andrej Rode.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * AVX2 implementations of the fused GFDM kernels, compiled with -mavx2 -mfma.
+ */
+
+#include "simd_kernels_impl.h"
+#include <immintrin.h>
+
+namespace gr {
+  namespace gfdm {
+    namespace simd {
+
+      namespace {
+        // 4 complex values per register.
+        inline __m256
+        complex_multiply(__m256 x, __m256 h)
+        {
+          const __m256 h_re = _mm256_moveldup_ps(h);
+          const __m256 h_im = _mm256_movehdup_ps(h);
+          const __m256 x_swap = _mm256_permute_ps(x, 0xb1);
+          return _mm256_fmaddsub_ps(x, h_re, _mm256_mul_ps(x_swap, h_im));
+        }
+      }
+
+      void
+      multiply_add_avx2(float* target, const float* in, const float* taps, int n)
+      {
+        int i = 0;
+        for(; i + 4 <= n; i += 4){
+          const __m256 z = complex_multiply(_mm256_loadu_ps(in + 2 * i), _mm256_loadu_ps(taps + 2 * i));
+          _mm256_storeu_ps(target + 2 * i, _mm256_add_ps(_mm256_loadu_ps(target + 2 * i), z));
+        }
+        multiply_add_scalar(target + 2 * i, in + 2 * i, taps + 2 * i, n - i);
+      }
+
+      void
+      multiply_fold_avx2(float* out, const float* const* rows, const float* taps, int n, int fold, int taps_stride)
+      {
+        int m = 0;
+        for(; m + 4 <= n; m += 4){
+          __m256 acc = _mm256_setzero_ps();
+          for(int l = 0; l < fold; l++){
+            const __m256 h = _mm256_loadu_ps(taps + 2 * (l * taps_stride + m));
+            acc = _mm256_add_ps(acc, complex_multiply(_mm256_loadu_ps(rows[l] + 2 * m), h));
+          }
+          _mm256_storeu_ps(out + 2 * m, acc);
+        }
+        multiply_fold_scalar(out, rows, taps, m, n, fold, taps_stride);
+      }
+
+    } /* namespace simd */
+  } /* namespace gfdm */
+} /* namespace gr */
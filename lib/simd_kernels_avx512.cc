@@ -0,0 +1,77 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2016 Andrej Rode.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * AVX-512F implementations of the fused GFDM kernels, compiled with -mavx512f.
+ */
+
+#include "simd_kernels_impl.h"
+#include <immintrin.h>
+
+namespace gr {
+  namespace gfdm {
+    namespace simd {
+
+      namespace {
+        // 8 complex values per register.
+        inline __m512
+        complex_multiply(__m512 x, __m512 h)
+        {
+          const __m512 h_re = _mm512_moveldup_ps(h);
+          const __m512 h_im = _mm512_movehdup_ps(h);
+          const __m512 x_swap = _mm512_permute_ps(x, 0xb1);
+          return _mm512_fmaddsub_ps(x, h_re, _mm512_mul_ps(x_swap, h_im));
+        }
+
+        // the tail is handled with masked loads, which do not fault past the end.
+        inline __mmask16
+        tail_mask(int remaining)
+        {
+          return remaining >= 8 ? __mmask16(0xffff) : __mmask16((1u << (2 * remaining)) - 1);
+        }
+      }
+
+      void
+      multiply_add_avx512(float* target, const float* in, const float* taps, int n)
+      {
+        for(int i = 0; i < n; i += 8){
+          const __mmask16 k = tail_mask(n - i);
+          const __m512 z = complex_multiply(_mm512_maskz_loadu_ps(k, in + 2 * i), _mm512_maskz_loadu_ps(k, taps + 2 * i));
+          _mm512_mask_storeu_ps(target + 2 * i, k, _mm512_add_ps(_mm512_maskz_loadu_ps(k, target + 2 * i), z));
+        }
+      }
+
+      void
+      multiply_fold_avx512(float* out, const float* const* rows, const float* taps, int n, int fold, int taps_stride)
+      {
+        for(int m = 0; m < n; m += 8){
+          const __mmask16 k = tail_mask(n - m);
+          __m512 acc = _mm512_setzero_ps();
+          for(int l = 0; l < fold; l++){
+            const __m512 h = _mm512_maskz_loadu_ps(k, taps + 2 * (l * taps_stride + m));
+            acc = _mm512_add_ps(acc, complex_multiply(_mm512_maskz_loadu_ps(k, rows[l] + 2 * m), h));
+          }
+          _mm512_mask_storeu_ps(out + 2 * m, k, acc);
+        }
+      }
+
+    } /* namespace simd */
+  } /* namespace gfdm */
+} /* namespace gr */
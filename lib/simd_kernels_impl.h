@@ -0,0 +1,86 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2016 Andrej Rode.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_GFDM_SIMD_KERNELS_IMPL_H
+#define INCLUDED_GFDM_SIMD_KERNELS_IMPL_H
+
+/*
+ * Per-architecture bodies of the kernels in gfdm/simd_kernels.h. They work on
+ * contiguous interleaved complex floats, simd_kernels.cc splits the circular
+ * ranges. Each simd_kernels_<arch>.cc is compiled with its own -m flags, so
+ * this header MUST NOT pull in anything with inline functions that could be
+ * shared with code compiled for the baseline architecture.
+ */
+
+namespace gr {
+  namespace gfdm {
+    namespace simd {
+
+      //! target[i] += in[i] * taps[i], n complex values.
+      typedef void (*multiply_add_fn)(float* target, const float* in, const float* taps, int n);
+      //! out[m] = sum over l < fold of rows[l][m] * taps[l * taps_stride + m], n complex values.
+      typedef void (*multiply_fold_fn)(float* out, const float* const* rows, const float* taps,
+                                       int n, int fold, int taps_stride);
+
+      static inline void
+      multiply_add_scalar(float* target, const float* in, const float* taps, int n)
+      {
+        for(int i = 0; i < 2 * n; i += 2){
+          target[i] += in[i] * taps[i] - in[i + 1] * taps[i + 1];
+          target[i + 1] += in[i] * taps[i + 1] + in[i + 1] * taps[i];
+        }
+      }
+
+      static inline void
+      multiply_fold_scalar(float* out, const float* const* rows, const float* taps,
+                           int begin, int end, int fold, int taps_stride)
+      {
+        for(int m = begin; m < end; m++){
+          float re = 0.0f;
+          float im = 0.0f;
+          for(int l = 0; l < fold; l++){
+            const float* x = rows[l] + 2 * m;
+            const float* h = taps + 2 * (l * taps_stride + m);
+            re += x[0] * h[0] - x[1] * h[1];
+            im += x[0] * h[1] + x[1] * h[0];
+          }
+          out[2 * m] = re;
+          out[2 * m + 1] = im;
+        }
+      }
+
+#ifdef GFDM_HAVE_SSE3
+      void multiply_add_sse3(float* target, const float* in, const float* taps, int n);
+      void multiply_fold_sse3(float* out, const float* const* rows, const float* taps, int n, int fold, int taps_stride);
+#endif
+#ifdef GFDM_HAVE_AVX2
+      void multiply_add_avx2(float* target, const float* in, const float* taps, int n);
+      void multiply_fold_avx2(float* out, const float* const* rows, const float* taps, int n, int fold, int taps_stride);
+#endif
+#ifdef GFDM_HAVE_AVX512
+      void multiply_add_avx512(float* target, const float* in, const float* taps, int n);
+      void multiply_fold_avx512(float* out, const float* const* rows, const float* taps, int n, int fold, int taps_stride);
+#endif
+
+    } /* namespace simd */
+  } /* namespace gfdm */
+} /* namespace gr */
+
+#endif /* INCLUDED_GFDM_SIMD_KERNELS_IMPL_H */
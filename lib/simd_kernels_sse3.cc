@@ -0,0 +1,72 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2016 Andrej Rode.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * SSE3 implementations of the fused GFDM kernels, compiled with -msse3.
+ */
+
+#include "simd_kernels_impl.h"
+#include <pmmintrin.h>
+
+namespace gr {
+  namespace gfdm {
+    namespace simd {
+
+      namespace {
+        // 2 complex values per register.
+        inline __m128
+        complex_multiply(__m128 x, __m128 h)
+        {
+          const __m128 h_re = _mm_moveldup_ps(h);
+          const __m128 h_im = _mm_movehdup_ps(h);
+          const __m128 x_swap = _mm_shuffle_ps(x, x, 0xb1);
+          return _mm_addsub_ps(_mm_mul_ps(x, h_re), _mm_mul_ps(x_swap, h_im));
+        }
+      }
+
+      void
+      multiply_add_sse3(float* target, const float* in, const float* taps, int n)
+      {
+        int i = 0;
+        for(; i + 2 <= n; i += 2){
+          const __m128 z = complex_multiply(_mm_loadu_ps(in + 2 * i), _mm_loadu_ps(taps + 2 * i));
+          _mm_storeu_ps(target + 2 * i, _mm_add_ps(_mm_loadu_ps(target + 2 * i), z));
+        }
+        multiply_add_scalar(target + 2 * i, in + 2 * i, taps + 2 * i, n - i);
+      }
+
+      void
+      multiply_fold_sse3(float* out, const float* const* rows, const float* taps, int n, int fold, int taps_stride)
+      {
+        int m = 0;
+        for(; m + 2 <= n; m += 2){
+          __m128 acc = _mm_setzero_ps();
+          for(int l = 0; l < fold; l++){
+            const __m128 h = _mm_loadu_ps(taps + 2 * (l * taps_stride + m));
+            acc = _mm_add_ps(acc, complex_multiply(_mm_loadu_ps(rows[l] + 2 * m), h));
+          }
+          _mm_storeu_ps(out + 2 * m, acc);
+        }
+        multiply_fold_scalar(out, rows, taps, m, n, fold, taps_stride);
+      }
+
+    } /* namespace simd */
+  } /* namespace gfdm */
+} /* namespace gr */
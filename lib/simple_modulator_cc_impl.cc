@@ -24,6 +24,8 @@
 
 #include <gnuradio/io_signature.h>
 #include "simple_modulator_cc_impl.h"
+#include <gfdm/tracer.h>
+#include <gfdm/stage_timers_pmt.h>
 
 namespace gr {
   namespace gfdm {
@@ -41,10 +43,14 @@ namespace gr {
     simple_modulator_cc_impl::simple_modulator_cc_impl(int n_timeslots, int n_subcarriers, int overlap, std::vector<gr_complex> frequency_taps)
       : gr::sync_block("simple_modulator_cc",
               gr::io_signature::make(1, 1, sizeof(gr_complex)),
-              gr::io_signature::make(1, 1, sizeof(gr_complex)))
+              gr::io_signature::make(1, 1, sizeof(gr_complex))),
+      d_stage_timing_interval(1000), d_frames_since_timing(0)
     {
       d_kernel = modulator_kernel_cc::sptr(new modulator_kernel_cc(n_timeslots, n_subcarriers, overlap, frequency_taps));
       set_output_multiple(d_kernel->block_size());
+
+      d_stage_timing_port = pmt::mp("stage_timing");
+      message_port_register_out(d_stage_timing_port);
     }
 
     /*
@@ -54,6 +60,27 @@ namespace gr {
     {
     }
 
+    pmt::pmt_t
+    simple_modulator_cc_impl::stage_timing()
+    {
+      gr::thread::scoped_lock guard(d_setlock);
+      return stage_timers_to_pmt(d_kernel->stage_timing());
+    }
+
+    void
+    simple_modulator_cc_impl::reset_stage_timing()
+    {
+      gr::thread::scoped_lock guard(d_setlock);
+      d_kernel->stage_timing().reset();
+    }
+
+    void
+    simple_modulator_cc_impl::set_stage_timing_interval(int n_frames)
+    {
+      gr::thread::scoped_lock guard(d_setlock);
+      d_stage_timing_interval = n_frames;
+    }
+
     int
     simple_modulator_cc_impl::work(int noutput_items,
         gr_vector_const_void_star &input_items,
@@ -63,6 +90,8 @@ namespace gr {
       gr_complex *out = (gr_complex *) output_items[0];
 
       const int n_blocks = noutput_items / d_kernel->block_size();
+      trace_span span("simple_modulator_cc::work");
+      span.set_frames(n_blocks);
 //      std::cout << "noutput_items = " << noutput_items << ", block_size = " << d_kernel->block_size() << ", #blocks = " << n_blocks << std::endl;
       for (int i = 0; i < n_blocks; ++i) {
         d_kernel->generic_work(out, in);
@@ -70,6 +99,14 @@ namespace gr {
         out += d_kernel->block_size();
       }
 
+#ifdef GFDM_STAGE_TIMERS
+      d_frames_since_timing += n_blocks;
+      if(d_stage_timing_interval > 0 && d_frames_since_timing >= d_stage_timing_interval){
+        message_port_pub(d_stage_timing_port, stage_timers_to_pmt(d_kernel->stage_timing()));
+        d_frames_since_timing = 0;
+      }
+#endif
+
       // Tell runtime system how many output items we produced.
       return noutput_items;
     }
@@ -32,11 +32,16 @@ namespace gr {
      private:
       // Nothing to declare in this block.
       modulator_kernel_cc::sptr d_kernel;
-
+      pmt::pmt_t d_stage_timing_port;
+      int d_stage_timing_interval;
+      int d_frames_since_timing;
 
      public:
       simple_modulator_cc_impl(int n_timeslots, int n_subcarriers, int overlap, std::vector<gr_complex> frequency_taps);
       ~simple_modulator_cc_impl();
+      pmt::pmt_t stage_timing();
+      void reset_stage_timing();
+      void set_stage_timing_interval(int n_frames);
 
       // Where all the action really happens
       int work(int noutput_items,
@@ -0,0 +1,117 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2016 Andrej Rode.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <gfdm/stage_timers.h>
+#include <boost/thread/once.hpp>
+#include <algorithm>
+
+namespace gr {
+  namespace gfdm {
+
+    namespace {
+      double s_ticks_per_ns = 1.0;
+      boost::once_flag s_calibrated = BOOST_ONCE_INIT;
+
+      void
+      calibrate()
+      {
+#if defined(__i386__) || defined(__x86_64__)
+        // spin for 10ms, long enough to make the TSC/clock read-out jitter negligible.
+        const uint64_t ns_start = stage_timers::monotonic_ns();
+        const uint64_t tsc_start = stage_timers::now();
+        uint64_t ns_now;
+        do{
+          ns_now = stage_timers::monotonic_ns();
+        } while(ns_now - ns_start < 10000000);
+        const uint64_t tsc_len = stage_timers::now() - tsc_start;
+        s_ticks_per_ns = double(tsc_len) / double(ns_now - ns_start);
+#else
+        s_ticks_per_ns = 1.0;
+#endif
+      }
+    }
+
+    stage_timers::stage_timers(const char* const* stage_names, int n_stages)
+      : d_names(stage_names, stage_names + n_stages), d_last(0), d_n_frames(0),
+        d_frame_ticks(n_stages, 0), d_total_ticks(n_stages, 0), d_histogram(n_stages * N_BUCKETS, 0)
+    {
+    }
+
+    bool
+    stage_timers::compiled_in()
+    {
+#ifdef GFDM_STAGE_TIMERS
+      return true;
+#else
+      return false;
+#endif
+    }
+
+    double
+    stage_timers::ticks_per_ns()
+    {
+      boost::call_once(s_calibrated, &calibrate);
+      return s_ticks_per_ns;
+    }
+
+    void
+    stage_timers::commit()
+    {
+      for(int s = 0; s < n_stages(); s++){
+        const uint64_t ticks = d_frame_ticks[s];
+        int bucket = 0;
+        if(ticks > 1){
+          bucket = std::min(63 - __builtin_clzll(ticks), N_BUCKETS - 1);
+        }
+        d_histogram[s * N_BUCKETS + bucket]++;
+        d_total_ticks[s] += ticks;
+        d_frame_ticks[s] = 0;
+      }
+      d_n_frames++;
+    }
+
+    void
+    stage_timers::reset()
+    {
+      std::fill(d_frame_ticks.begin(), d_frame_ticks.end(), 0);
+      std::fill(d_total_ticks.begin(), d_total_ticks.end(), 0);
+      std::fill(d_histogram.begin(), d_histogram.end(), 0);
+      d_n_frames = 0;
+    }
+
+    double
+    stage_timers::mean_ns(int stage) const
+    {
+      if(d_n_frames == 0){
+        return 0.0;
+      }
+      return double(d_total_ticks[stage]) / (double(d_n_frames) * ticks_per_ns());
+    }
+
+    std::vector<uint64_t>
+    stage_timers::histogram(int stage) const
+    {
+      return std::vector<uint64_t>(d_histogram.begin() + stage * N_BUCKETS,
+                                   d_histogram.begin() + (stage + 1) * N_BUCKETS);
+    }
+
+  } /* namespace gfdm */
+} /* namespace gr */
+
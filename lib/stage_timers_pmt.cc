@@ -0,0 +1,44 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2016 Andrej Rode.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <gfdm/stage_timers_pmt.h>
+
+namespace gr {
+  namespace gfdm {
+
+    pmt::pmt_t
+    stage_timers_to_pmt(const stage_timers& timers)
+    {
+      pmt::pmt_t info = pmt::make_dict();
+      info = pmt::dict_add(info, pmt::mp("frames"), pmt::from_uint64(timers.n_frames()));
+      info = pmt::dict_add(info, pmt::mp("ticks_per_ns"), pmt::from_double(stage_timers::ticks_per_ns()));
+      for(int s = 0; s < timers.n_stages(); s++){
+        const std::vector<uint64_t> histogram = timers.histogram(s);
+        pmt::pmt_t stage = pmt::make_dict();
+        stage = pmt::dict_add(stage, pmt::mp("mean_ns"), pmt::from_double(timers.mean_ns(s)));
+        stage = pmt::dict_add(stage, pmt::mp("histogram"),
+                              pmt::init_u64vector(histogram.size(), &histogram[0]));
+        info = pmt::dict_add(info, pmt::mp(timers.stage_name(s)), stage);
+      }
+      return info;
+    }
+
+  } /* namespace gfdm */
+} /* namespace gr */
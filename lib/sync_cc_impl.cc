@@ -24,39 +24,75 @@
 
 #include <gnuradio/io_signature.h>
 #include "sync_cc_impl.h"
+#include <gfdm/tracer.h>
 
 namespace gr {
   namespace gfdm {
 
     sync_cc::sptr
-    sync_cc::make(int sync_fft_len, int cp_length, int fft_len, gr::gfdm::preamble_generator_sptr preamble_generator, const std::string& gfdm_tag_key)
+    sync_cc::make(int sync_fft_len, int cp_length, int fft_len, gr::gfdm::preamble_generator_sptr preamble_generator, const std::string& gfdm_tag_key, float lock_threshold, int track_window, float autocorr_threshold, int search_window, float energy_threshold_db)
     {
       return gnuradio::get_initial_sptr
-        (new sync_cc_impl(sync_fft_len, cp_length, fft_len, preamble_generator, gfdm_tag_key));
+        (new sync_cc_impl(sync_fft_len, cp_length, fft_len, preamble_generator, gfdm_tag_key, lock_threshold, track_window, autocorr_threshold, search_window, energy_threshold_db));
     }
 
     /*
      * The private constructor
      */
-    sync_cc_impl::sync_cc_impl(int sync_fft_len, int cp_length, int fft_len, gr::gfdm::preamble_generator_sptr preamble_generator, const std::string& gfdm_tag_key)
+    sync_cc_impl::sync_cc_impl(int sync_fft_len, int cp_length, int fft_len, gr::gfdm::preamble_generator_sptr preamble_generator, const std::string& gfdm_tag_key, float lock_threshold, int track_window, float autocorr_threshold, int search_window, float energy_threshold_db)
       : gr::block("sync_cc",
               gr::io_signature::make(1, 1, sizeof(gr_complex)),
-              gr::io_signature::make3(1, 4, sizeof(gr_complex),sizeof(gr_complex),sizeof(float))),
-      d_initialized(false),
+              gr::io_signature::make3(0, 4, sizeof(gr_complex),sizeof(gr_complex),sizeof(float))),
       d_fft_len(fft_len),
       d_sync_fft_len(sync_fft_len),
       d_cp_length(cp_length),
       d_block_len(2*cp_length+fft_len+sync_fft_len),
       d_L(sync_fft_len/2),
       d_preamble_generator(preamble_generator),
-      d_gfdm_tag_key(gfdm_tag_key)
+      d_plateau_sum(0.0),
+      d_plateau_since_anchor(0),
+      d_plateau_anchor_interval(1024),
+      d_gfdm_tag_key(gfdm_tag_key),
+      d_state(STATE_SEARCH),
+      d_lock_threshold(lock_threshold),
+      d_max_missed_frames(2),
+      d_missed_frames(0),
+      d_expected_frame(0),
+      d_autocorr_threshold(autocorr_threshold),
+      d_frame_autocorr_metric(0.0f),
+      d_frame_xcorr_metric(0.0f),
+      d_frame_cfo(0.0f),
+      d_frame_snr_db(0.0f),
+      d_frame_timing_offset(0),
+      d_frames_detected(0),
+      d_frames_missed(0),
+      d_locks_acquired(0),
+      d_locks_lost(0),
+      d_idle_blocks(0),
+      d_autocorr_lags(0),
+      d_xcorr_lags(0),
+      d_noise_floor(0.0f),
+      d_noise_floor_alpha(0.05f)
     {
       set_tag_propagation_policy(TPP_DONT);
       set_history(2);
+      d_gfdm_tag_key_pmt = pmt::string_to_symbol(d_gfdm_tag_key);
+      d_lock_tag_key = pmt::string_to_symbol("gfdm_sync_lock");
+      d_cfo_tag_key = pmt::string_to_symbol("gfdm_cfo");
+      d_timing_tag_key = pmt::string_to_symbol("gfdm_timing_offset");
+      d_metric_tag_key = pmt::string_to_symbol("gfdm_sync_metric");
+      d_snr_tag_key = pmt::string_to_symbol("gfdm_snr_db");
+      d_sync_port = pmt::mp("sync");
+      message_port_register_out(d_sync_port);
       // Make sure to have only multiple of( one GFDM Block + Sync) in input
       gr::block::set_output_multiple( d_block_len+d_sync_fft_len );
       d_P_d_abs_prev.resize(cp_length,0);
-      d_known_preamble = d_preamble_generator->get_preamble();
+      d_kernel = sync_kernel_cc::sptr(new sync_kernel_cc(d_preamble_generator, d_block_len));
+      d_cfo_nco = nco_cc::sptr(new nco_cc());
+      set_track_window(track_window);
+      set_search_window(search_window);
+      set_energy_threshold_db(energy_threshold_db);
+      d_gate_energy.resize(d_block_len);
     }
 
     /*
@@ -66,6 +102,60 @@ namespace gr {
     {
     }
 
+    void
+    sync_cc_impl::set_lock_threshold(float lock_threshold)
+    {
+      gr::thread::scoped_lock guard(d_setlock);
+      d_lock_threshold = lock_threshold;
+    }
+
+    void
+    sync_cc_impl::set_track_window(int track_window)
+    {
+      if (track_window < 0 || 2*track_window >= d_block_len/2)
+      {
+        throw std::invalid_argument("track_window must be non-negative and smaller than a quarter of the frame length");
+      }
+      gr::thread::scoped_lock guard(d_setlock);
+      d_track_window = track_window;
+      d_track_buf.resize(2*d_track_window+d_sync_fft_len);
+      d_track_cc.resize(2*d_track_window+1);
+      d_track_cc_abs.resize(2*d_track_window+1);
+    }
+
+    void
+    sync_cc_impl::set_autocorr_threshold(float autocorr_threshold)
+    {
+      gr::thread::scoped_lock guard(d_setlock);
+      d_autocorr_threshold = autocorr_threshold;
+    }
+
+    void
+    sync_cc_impl::set_search_window(int search_window)
+    {
+      if (search_window < 0 || 2*search_window >= d_block_len)
+      {
+        throw std::invalid_argument("search_window must be non-negative and smaller than half the frame length");
+      }
+      gr::thread::scoped_lock guard(d_setlock);
+      d_search_window = search_window;
+    }
+
+    void
+    sync_cc_impl::set_energy_threshold_db(float energy_threshold_db)
+    {
+      gr::thread::scoped_lock guard(d_setlock);
+      d_energy_threshold_db = energy_threshold_db;
+      d_energy_threshold = std::pow(10.0f, energy_threshold_db/10.0f);
+    }
+
+    void
+    sync_cc_impl::set_max_missed_frames(int max_missed_frames)
+    {
+      gr::thread::scoped_lock guard(d_setlock);
+      d_max_missed_frames = max_missed_frames;
+    }
+
     void
     sync_cc_impl::forecast (int noutput_items, gr_vector_int &ninput_items_required)
     {
@@ -79,35 +169,83 @@ namespace gr {
                        gr_vector_void_star &output_items)
     {
       const gr_complex *in = (const gr_complex *) input_items[0];
-      gr_complex *out = (gr_complex *) output_items[0];
-      gr_complex *corr_out;
-      float *corr_i_out;
-      float *res_out;
+      const int max_consume = std::min(noutput_items, ninput_items[0]);
+
+      int nconsume;
+      if (d_state == STATE_SEARCH)
+      {
+        trace_span span("sync_cc::search");
+        nconsume = search(output_items, in);
+      }else
+      {
+        trace_span span("sync_cc::track");
+        nconsume = track(output_items, &in[1], max_consume-d_sync_fft_len, max_consume);
+      }
+
+      //in[0] is last item of previous block
+      //Without a stream output the block only publishes on the "sync" port, no samples are copied.
+      //frame_receiver_cc can then take the frame starts from that port and read the samples itself.
+      if (!output_items.empty())
+      {
+        std::memcpy(output_items[0],&in[1],sizeof(gr_complex)*nconsume);
+      }
+      // Tell message subscribers how far frames have been searched for
+      if (!pmt::is_null(message_subscribers(d_sync_port)))
+      {
+        message_port_pub(d_sync_port, pmt::dict_add(pmt::make_dict(), pmt::mp("processed"), pmt::from_uint64(nitems_read(0)+nconsume)));
+      }
+      consume_each(nconsume);
+      
+      return nconsume;
+    }
+
+    int
+    sync_cc_impl::search (gr_vector_void_star &output_items, const gr_complex in[])
+    {
+      const gr_complex *samples = &in[1];
+
+      //Idle channel: skip the correlation pipeline and produce no frames
+      float mean_power;
+      if (channel_idle(samples, mean_power))
+      {
+        update_noise_floor(mean_power, true);
+        d_idle_blocks.fetch_add(1, boost::memory_order_relaxed);
+        // The skipped block breaks the plateau recursion, restart it like an unlock does
+        d_plateau_since_anchor = 0;
+        std::fill(d_P_d_abs_prev.begin(), d_P_d_abs_prev.end(), 0.0f);
+        if (output_items.size()>1)
+        {
+          std::memcpy(output_items[1],&samples[0],sizeof(gr_complex)*d_block_len);
+        }
+        for (unsigned int port=2; port<output_items.size(); port++)
+        {
+          std::memset(output_items[port], 0x00, sizeof(float)*d_block_len);
+        }
+        return d_block_len;
+      }
 
       //Initialize some vectors to hold Correlation_data
       //P_d: (complex) autocorrelation of length sync_fft_len/2 to detect signal with two identical halves length sync_fft_len
       //P_d_abs: absolute value
       //P_d_i: integrated P_d_abs -cp_length:0 to eliminate CP Plateau
+      //P_d_norm: |P_d|/R with R the energy of the second half (Schmidl & Cox metric)
       std::vector<gr_complex> P_d(d_block_len);
       //Add last (length cp_length) samples from P_d_abs to start (to integrate cp_length samples)
       std::vector<float> P_d_abs(d_block_len+d_cp_length);
       std::vector<float> P_d_i(d_block_len);
+      std::vector<float> P_d_norm(d_block_len);
       
       // Main task: autocorrelate L samples with following L samples -> need to know whats the upsampling factor
       // Flow:
-      // 1. autocorrelate L samples with next L samples and save value.
-      // 2. multiply/conjugate L+1 with (2*L+1) and add to autocorrelation value
-      // 3. multiply/conjugate 0 and L and subtract from autocorrelation value
-      // (4. detect plateau{ Integrate (length CP) along previous autocorrelation values })
-      // (5. match against threshold (detect max/first peak -> multipath))
+      // 1. multiply/conjugate every sample with the one L later
+      // 2. slide the L-sum along the products, re-anchored with an exact dot product every block
+      // 3. detect plateau{ Integrate (length CP) along previous autocorrelation values }
+      // 4. threshold |P|/R to get candidate lags
+      // 5. crosscorrelate the known preamble around candidates only
       //
       // We have sync_fft_len + H*(2*cp_length+fft_len+sync_fft_len+sync_fft_len/2) items
-      if (!d_initialized)
-      {
-        initialize(in); //Initial Value in 
-        d_initialized = true;
-      }
-      iterate(&P_d[0], &in[0], d_block_len);
+      d_kernel->autocorrelate(&P_d[0], &samples[0], d_block_len);
+      d_autocorr_lags.fetch_add(d_block_len, boost::memory_order_relaxed);
       
       //Now integrate along time axis (length cp)
       if (d_cp_length)
@@ -115,121 +253,373 @@ namespace gr {
         ::volk_32fc_magnitude_32f(&P_d_abs[d_cp_length],&P_d[0],d_block_len);
         std::memcpy(&P_d_abs[0],&d_P_d_abs_prev[0],sizeof(float)*d_cp_length);
         std::memcpy(&d_P_d_abs_prev[0],&P_d_abs[d_block_len],sizeof(float)*d_cp_length);
-        for (int i=0;i<(d_block_len);i++)
-        {
-          for (int k=0;k<d_cp_length;k++)
-          {
-            P_d_i[i] += P_d_abs[i+k];
-          }
-        }
+        integrate_plateau(&P_d_i[0], &P_d_abs[0], d_block_len);
       }else
       {
         ::volk_32fc_magnitude_32f(&P_d_abs[0], &P_d[0],d_block_len);
         std::memcpy(&P_d_i[0],&P_d_abs[0],sizeof(float)*d_block_len);
       }
 
-      
-      //Find max abs
-      std::vector<float>::iterator max;
-      max = std::max_element(P_d_i.begin(),P_d_i.end());
-      int max_index1 = std::distance(P_d_i.begin(),max);
-      //Calculate angle <P_d
-      float angle =(float) std::atan2((double) std::imag(P_d[max_index1]), (double) std::real(P_d[max_index1]));
-      float cfo = angle/M_PI;
-
-      //std::cout << "Carrier Frequency Offset: " <<cfo<<std::endl;
-      
-      //Correct CFO with epsilon = angle/pi
-      std::vector<gr_complex> cfo_correction(d_block_len+d_sync_fft_len);
-      for (int i=0;i<(d_block_len+d_sync_fft_len);i++)
+      //P_d is already divided by L, so is the energy of the second half
+      window_energy(&P_d_norm[0], &samples[d_L], d_L, d_block_len);
+      for (int i=0; i<d_block_len; i++)
       {
-        cfo_correction[i] = std::exp( gr_complex(2j*M_PI*(cfo/(d_sync_fft_len/2))*i));
+        P_d_norm[i] = P_d_norm[i] > 0.0f ? d_L*P_d_abs[d_cp_length+i]/P_d_norm[i] : 0.0f;
       }
-      std::vector<gr_complex> corrected_input_sequence(d_block_len+d_sync_fft_len);
-      ::volk_32fc_x2_multiply_32fc(&corrected_input_sequence[0],&cfo_correction[0],&in[1],d_block_len+d_sync_fft_len);
-      //Crosscorrelate known preamble and sync_preamble
+
+      std::vector<search_window_t> windows;
+      find_candidates(windows, &P_d_norm[0], &P_d_i[0]);
+
+      //Crosscorrelate known preamble and CFO corrected input within candidate windows
       //Known Preamble must have length d_sync_fft_len
-      std::vector<gr_complex> cross_correlation(d_block_len);
-      for (int i=0; i<(d_block_len);i++)
+      std::vector<gr_complex> cross_correlation(d_block_len, 0j);
+      std::vector<float> cc_abs(d_block_len, 0.0f);
+      std::vector<gr_complex> corrected_window;
+      int frame_index = -1;
+      int frame_candidate = 0;
+      float frame_metric = 0.0f;
+      float frame_cfo = 0.0f;
+      const double phase = d_cfo_nco->phase();
+      for (unsigned int w=0; w<windows.size(); w++)
       {
-        std::vector<gr_complex> cc_tmp(d_sync_fft_len);
-        ::volk_32fc_x2_multiply_conjugate_32fc(&cc_tmp[0],&d_known_preamble[0],&corrected_input_sequence[i],d_sync_fft_len);
-        for (int k=0; k<d_sync_fft_len;k++)
+        const int first = windows[w].first;
+        const int n_window = windows[w].last - first + 1;
+        //Calculate angle <P_d, normalized to the preamble subcarrier spacing
+        float cfo = std::arg(P_d[windows[w].candidate])/M_PI;
+        corrected_window.resize(n_window+d_sync_fft_len-1);
+        d_cfo_nco->set_frequency(-cfo/d_sync_fft_len);
+        d_cfo_nco->rotate(&corrected_window[0],&samples[first],n_window+d_sync_fft_len-1);
+        d_kernel->correlate_window(&cross_correlation[first],&corrected_window[0],n_window);
+        d_xcorr_lags.fetch_add(n_window, boost::memory_order_relaxed);
+        ::volk_32fc_magnitude_32f(&cc_abs[first],&cross_correlation[first],n_window);
+
+        int peak = std::distance(cc_abs.begin(),std::max_element(cc_abs.begin()+first,cc_abs.begin()+first+n_window));
+        float metric = d_kernel->normalized_metric(cross_correlation[peak],&samples[peak]);
+        if (metric > frame_metric)
         {
-          cross_correlation[i] += (gr_complex) (((gr_complex)1.0) / ((gr_complex) d_sync_fft_len)) * cc_tmp[k];
+          frame_index = peak;
+          frame_candidate = windows[w].candidate;
+          frame_metric = metric;
+          frame_cfo = cfo;
         }
       }
-      //multiply crosscorelation with P_d (autocorrelation)
-      std::vector<float> cc_abs(d_block_len);
-      ::volk_32fc_magnitude_32f(&cc_abs[0],&cross_correlation[0],d_block_len);
-      std::vector<float> P_d_res(d_block_len);
-      ::volk_32f_x2_multiply_32f(&P_d_res[0],&cc_abs[0],&P_d_abs[0],d_block_len);
-
-      max = std::max_element(P_d_res.begin(),P_d_res.end());
-      int max_index2 = std::distance(P_d_res.begin(),max);
+      d_cfo_nco->set_phase(phase);
 
-      //Add evaluation with threshold and multipath detection (argfirst)
-      //Add Stream tags on max
-      
-      //std::cout << "First Autocorrelation maximum: " << max_index1 <<std::endl;
-      //std::cout << "CC maximum: " << max_index2 <<std::endl;
-      
-      add_item_tag(0, nitems_written(0)+max_index2,
-          pmt::string_to_symbol(d_gfdm_tag_key),
-          pmt::from_long(d_sync_fft_len));
+      //Only accept frames with a sufficient normalized cross-correlation peak, then lock onto them.
+      //Add multipath detection (argfirst)
+      bool detected = frame_metric >= d_lock_threshold;
+      if (frame_index >= 0)
+      {
+        set_frame_metrics(P_d_norm[frame_candidate], frame_metric, frame_cfo, frame_index - frame_candidate);
+      }
+      if (!detected)
+      {
+        update_noise_floor(mean_power, false);
+      }
+      if (detected)
+      {
+        frame_detected(frame_index, output_items.size());
+        set_locked(true, frame_index, output_items.size());
+        d_missed_frames = 0;
+        d_expected_frame = nitems_read(0) + frame_index + d_block_len;
+      }
 
-      //in[0] is last item of previous block
-      std::memcpy(&out[0],&in[1],sizeof(gr_complex)*d_block_len);
-      // Copy P_d into second (float) port
+      // Copy CFO corrected input into second (complex) port
       if (output_items.size()>1)
       {
-        corr_out = (gr_complex *) output_items[1];
-        std::memcpy(&corr_out[0],&corrected_input_sequence[0],sizeof(gr_complex)*d_block_len);
-        add_item_tag(1, nitems_written(0)+max_index2,
-          pmt::string_to_symbol(d_gfdm_tag_key),
-          pmt::from_long(d_sync_fft_len));
+        d_cfo_nco->set_frequency(-d_frame_cfo/d_sync_fft_len);
+        d_cfo_nco->rotate((gr_complex *) output_items[1],&samples[0],d_block_len);
       }
       if (output_items.size()>2)
       {
-        corr_i_out = (float *) output_items[2];
-        std::memcpy(&corr_i_out[0],&P_d_i[0],sizeof(float)*d_block_len);
-        add_item_tag(2, nitems_written(0)+max_index1,
-            pmt::string_to_symbol(d_gfdm_tag_key),
-            pmt::from_long(d_sync_fft_len));       
+        std::memcpy(output_items[2],&P_d_i[0],sizeof(float)*d_block_len);
+        if (detected)
+        {
+          add_item_tag(2, nitems_read(0)+frame_candidate,
+              d_gfdm_tag_key_pmt,
+              pmt::from_long(d_sync_fft_len));
+        }
       }
+      // |crosscorrelation| within the searched windows, zero elsewhere
       if (output_items.size()>3)
       {
-        res_out = (float *) output_items[3];
-        std::memcpy(&res_out[0], &P_d_res[0], sizeof(float)*d_block_len);
+        std::memcpy(output_items[3], &cc_abs[0], sizeof(float)*d_block_len);
       }
-      consume_each(d_block_len);
-      
       return d_block_len;
     }
 
+    int
+    sync_cc_impl::track (gr_vector_void_star &output_items, const gr_complex samples[], int n_lags, int max_consume)
+    {
+      // Frames repeat every d_block_len items. Consumption is chosen such that the
+      // expected preamble sits in the middle of the next call, so the window never
+      // needs history or more lookahead than the search.
+      const int target = d_block_len/2;
+      const int expected = int(int64_t(d_expected_frame) - int64_t(nitems_read(0)));
+      int nconsume;
+      if (expected - d_track_window >= n_lags)
+      {
+        // Expected preamble lies beyond this call, pass items until it is centered.
+        nconsume = std::min(expected - target, max_consume);
+      }else
+      {
+        int position = expected;
+        bool detected = false;
+        const int first = std::max(0, expected - d_track_window);
+        const int last = std::min(n_lags - 1, expected + d_track_window);
+        if (first <= last)
+        {
+          float cfo;
+          const float autocorr = d_kernel->autocorr_metric(&samples[std::min(std::max(expected, 0), n_lags - 1)], cfo);
+          d_autocorr_lags.fetch_add(1, boost::memory_order_relaxed);
+          const double phase = d_cfo_nco->phase();
+          d_cfo_nco->set_frequency(-cfo/d_sync_fft_len);
+          // In steady state the peak sits at the expected lag: check it against its two
+          // neighbours first and only correlate the whole window if the timing moved.
+          int peak = -1;
+          if (first < expected && expected < last)
+          {
+            d_cfo_nco->rotate(&d_track_buf[0], &samples[expected-1], d_sync_fft_len + 2);
+            d_cfo_nco->set_phase(phase);
+            d_kernel->correlate_window(&d_track_cc[0], &d_track_buf[0], 3);
+            d_xcorr_lags.fetch_add(3, boost::memory_order_relaxed);
+            ::volk_32fc_magnitude_32f(&d_track_cc_abs[0],&d_track_cc[0],3);
+            if (d_track_cc_abs[1] >= d_track_cc_abs[0] && d_track_cc_abs[1] >= d_track_cc_abs[2]
+                && d_kernel->normalized_metric(d_track_cc[1], &samples[expected]) >= d_lock_threshold)
+            {
+              peak = expected - first;
+              d_track_cc[peak] = d_track_cc[1];
+            }
+          }
+          if (peak < 0)
+          {
+            const int n_window = last - first + 1;
+            d_cfo_nco->rotate(&d_track_buf[0], &samples[first], n_window + d_sync_fft_len - 1);
+            d_cfo_nco->set_phase(phase);
+            d_kernel->correlate_window(&d_track_cc[0], &d_track_buf[0], n_window);
+            d_xcorr_lags.fetch_add(n_window, boost::memory_order_relaxed);
+            ::volk_32fc_magnitude_32f(&d_track_cc_abs[0],&d_track_cc[0],n_window);
+            peak = std::distance(d_track_cc_abs.begin(), std::max_element(d_track_cc_abs.begin(), d_track_cc_abs.begin()+n_window));
+          }
+          set_frame_metrics(autocorr, d_kernel->normalized_metric(d_track_cc[peak], &samples[first+peak]), cfo, first + peak - expected);
+          if (d_frame_xcorr_metric >= d_lock_threshold)
+          {
+            position = first + peak;
+            detected = true;
+          }
+        }
+
+        if (detected)
+        {
+          d_missed_frames = 0;
+          frame_detected(position, output_items.size());
+        }else
+        {
+          d_frames_missed.fetch_add(1, boost::memory_order_relaxed);
+          if (++d_missed_frames > d_max_missed_frames)
+          {
+            set_locked(false, 0, output_items.size());
+          }
+        }
+        d_expected_frame = nitems_read(0) + position + d_block_len;
+        nconsume = std::max(1, std::min(position + d_block_len - target, max_consume));
+      }
+
+      // Debug ports only carry the corrected input while tracking, metrics are not computed.
+      if (output_items.size()>1)
+      {
+        d_cfo_nco->rotate((gr_complex *) output_items[1], samples, nconsume);
+      }
+      for (unsigned int port=2; port<output_items.size(); port++)
+      {
+        std::memset(output_items[port], 0x00, sizeof(float)*nconsume);
+      }
+      return nconsume;
+    }
+
     void
-    sync_cc_impl::initialize (const gr_complex in[])
+    sync_cc_impl::set_frame_metrics(float autocorr_metric, float xcorr_metric, float cfo, int timing_offset)
     {
-      d_autocorr_value = 0j;
-      std::vector<gr_complex> corr_out(d_L);
-      ::volk_32fc_x2_multiply_conjugate_32fc(&corr_out[0],&in[d_L],&in[0],d_L);
-      for (int i=0; i<d_L; i++)
+      d_frame_autocorr_metric = autocorr_metric;
+      d_frame_xcorr_metric = xcorr_metric;
+      d_frame_cfo = cfo;
+      d_frame_timing_offset = timing_offset;
+      // |P|/R = S/(S+N) on the repeated preamble halves
+      const float m = std::min(autocorr_metric, 0.999999f);
+      d_frame_snr_db = 10.0f*std::log10(std::max(m/(1.0f-m), 1e-6f));
+    }
+
+    void
+    sync_cc_impl::frame_detected(int offset, int nports)
+    {
+      const uint64_t frame_start = nitems_read(0)+offset;
+      d_frames_detected.fetch_add(1, boost::memory_order_relaxed);
+
+      // Building the dict costs more than tracking the frame, skip it if nobody listens.
+      if (!pmt::is_null(message_subscribers(d_sync_port)))
       {
-        d_autocorr_value += corr_out[i];
+        pmt::pmt_t info = pmt::make_dict();
+        info = pmt::dict_add(info, pmt::mp("offset"), pmt::from_uint64(frame_start));
+        info = pmt::dict_add(info, pmt::mp("cfo"), pmt::from_double(d_frame_cfo));
+        info = pmt::dict_add(info, pmt::mp("metric"), pmt::from_double(d_frame_xcorr_metric));
+        info = pmt::dict_add(info, pmt::mp("timing_offset"), pmt::from_long(d_frame_timing_offset));
+        info = pmt::dict_add(info, pmt::mp("snr_db"), pmt::from_double(d_frame_snr_db));
+        message_port_pub(d_sync_port, info);
+      }
+
+      if (nports>0)
+      {
+        add_item_tag(0, frame_start, d_gfdm_tag_key_pmt, pmt::from_long(d_sync_fft_len));
+        add_item_tag(0, frame_start, d_cfo_tag_key, pmt::from_double(d_frame_cfo));
+        add_item_tag(0, frame_start, d_timing_tag_key, pmt::from_long(d_frame_timing_offset));
+        add_item_tag(0, frame_start, d_metric_tag_key, pmt::from_double(d_frame_xcorr_metric));
+        add_item_tag(0, frame_start, d_snr_tag_key, pmt::from_double(d_frame_snr_db));
+      }
+      if (nports>1)
+      {
+        add_item_tag(1, frame_start, d_gfdm_tag_key_pmt, pmt::from_long(d_sync_fft_len));
+      }
+    }
+
+    void
+    sync_cc_impl::set_locked(bool locked, int offset, int nports)
+    {
+      d_state = locked ? STATE_TRACK : STATE_SEARCH;
+      if (!locked)
+      {
+        // Search restarts its recursions from scratch
+        d_plateau_since_anchor = 0;
+        std::fill(d_P_d_abs_prev.begin(), d_P_d_abs_prev.end(), 0.0f);
+      }
+      if (locked)
+      {
+        d_locks_acquired.fetch_add(1, boost::memory_order_relaxed);
+      }else
+      {
+        d_locks_lost.fetch_add(1, boost::memory_order_relaxed);
+      }
+      if (nports>0)
+      {
+        add_item_tag(0, nitems_read(0)+offset, d_lock_tag_key, pmt::from_bool(locked));
+      }
+    }
+
+    void
+    sync_cc_impl::window_energy(float out[], const gr_complex start[], int window_len, int num_items)
+    {
+      // Sliding sum of |x|^2 over window_len items, restarted from scratch every call.
+      std::vector<float> mag_sq(num_items+window_len-1);
+      ::volk_32fc_magnitude_squared_32f(&mag_sq[0],&start[0],num_items+window_len-1);
+      double sum = 0.0;
+      for (int i=0; i<window_len; i++)
+      {
+        sum += mag_sq[i];
+      }
+      for (int i=0; i<num_items; i++)
+      {
+        out[i] = sum;
+        if (i+1 < num_items)
+        {
+          sum += mag_sq[i+window_len] - mag_sq[i];
+        }
       }
-      d_autocorr_value *= (gr_complex) (1.0/d_L);
-      
     }
 
     void
-    sync_cc_impl::iterate( gr_complex out[], const gr_complex start[], int num_items)
+    sync_cc_impl::find_candidates(std::vector<search_window_t>& windows, const float metric[], const float plateau[])
+    {
+      // Every run of lags above the threshold yields one candidate at its plateau maximum.
+      // Overlapping windows are merged, so no lag is correlated twice.
+      int i = 0;
+      while (i < d_block_len)
+      {
+        if (metric[i] < d_autocorr_threshold)
+        {
+          i++;
+          continue;
+        }
+        int candidate = i;
+        for (; i < d_block_len && metric[i] >= d_autocorr_threshold; i++)
+        {
+          if (plateau[i] > plateau[candidate])
+          {
+            candidate = i;
+          }
+        }
+        search_window_t window;
+        window.first = std::max(0, candidate - d_search_window);
+        window.last = std::min(d_block_len - 1, candidate + d_search_window);
+        window.candidate = candidate;
+        if (!windows.empty() && window.first <= windows.back().last + 1)
+        {
+          windows.back().last = window.last;
+          if (plateau[candidate] > plateau[windows.back().candidate])
+          {
+            windows.back().candidate = candidate;
+          }
+        }else
+        {
+          windows.push_back(window);
+        }
+      }
+    }
+
+    bool
+    sync_cc_impl::channel_idle(const gr_complex samples[], float& mean_power)
     {
-      for (int i=0; i<num_items;i++)
+      // Sliding energy over one preamble length, its peak decides and its mean feeds the noise floor.
+      window_energy(&d_gate_energy[0], &samples[0], d_sync_fft_len, d_block_len);
+      float energy_sum;
+      ::volk_32f_accumulator_s32f(&energy_sum, &d_gate_energy[0], d_block_len);
+      mean_power = energy_sum/(d_block_len*d_sync_fft_len);
+      if (d_energy_threshold_db <= 0.0f || d_noise_floor <= 0.0f)
       {
-        d_autocorr_value -=((gr_complex) (1.0/d_L))*conj(start[i])*start[i+d_L];
-        d_autocorr_value +=((gr_complex) (1.0/d_L))*conj(start[d_L+i])*start[2*d_L+i];
-        out[i] = d_autocorr_value;
-       
+        return false;
+      }
+      const float peak_power = *std::max_element(d_gate_energy.begin(), d_gate_energy.end())/d_sync_fft_len;
+      return peak_power < d_energy_threshold*d_noise_floor;
+    }
+
+    void
+    sync_cc_impl::update_noise_floor(float mean_power, bool idle)
+    {
+      // Only idle blocks are known to hold noise alone and may raise the estimate.
+      // Busy blocks without a detected frame can still carry signal energy, they only pull it down.
+      if (d_noise_floor <= 0.0f)
+      {
+        d_noise_floor = mean_power;
+      }else if (idle)
+      {
+        d_noise_floor += d_noise_floor_alpha*(mean_power - d_noise_floor);
+      }else
+      {
+        d_noise_floor = std::min(d_noise_floor, mean_power);
+      }
+    }
+
+    void
+    sync_cc_impl::integrate_plateau( float out[], const float start[], int num_items)
+    {
+      // Sliding sum over d_cp_length values: out[i] = sum(start[i:i+d_cp_length]).
+      // d_plateau_sum carries across calls like d_P_d_abs_prev; it is recomputed
+      // exactly every d_plateau_anchor_interval items to bound float drift.
+      for (int i=0; i<num_items; i++)
+      {
+        if (d_plateau_since_anchor == 0)
+        {
+          double exact_sum = 0.0;
+          for (int k=0; k<d_cp_length; k++)
+          {
+            exact_sum += start[i+k];
+          }
+          d_plateau_sum = float(exact_sum);
+        }
+        out[i] = d_plateau_sum;
+        d_plateau_sum += start[i+d_cp_length] - start[i];
+        if (++d_plateau_since_anchor >= d_plateau_anchor_interval)
+        {
+          d_plateau_since_anchor = 0;
+        }
       }
     }
 
@@ -22,8 +22,11 @@
 #define INCLUDED_GFDM_SYNC_CC_IMPL_H
 
 #include <gfdm/sync_cc.h>
+#include <gfdm/sync_kernel_cc.h>
+#include <gfdm/nco_cc.h>
 #include <volk/volk.h>
 #include <pmt/pmt.h>
+#include <boost/atomic.hpp>
 
 namespace gr {
   namespace gfdm {
@@ -31,27 +34,107 @@ namespace gr {
     class sync_cc_impl : public sync_cc
     {
      private:
+       enum sync_state_t { STATE_SEARCH, STATE_TRACK };
+
        int d_fft_len;
        int d_sync_fft_len;
        int d_cp_length;
-       bool d_initialized;
        int d_block_len;
        int d_L;
-       gr_complex d_autocorr_value;
        gr::gfdm::preamble_generator_sptr d_preamble_generator;
-       std::vector<gr_complex> d_known_preamble;
+       sync_kernel_cc::sptr d_kernel;
+       nco_cc::sptr d_cfo_nco;
        std::vector<float> d_P_d_abs_prev;
+       float d_plateau_sum;
+       int d_plateau_since_anchor;
+       int d_plateau_anchor_interval;
        std::string d_gfdm_tag_key;
-       
-       void initialize( const gr_complex in[] );
-       void iterate( gr_complex out[], const gr_complex start[], int num_items);
 
+       sync_state_t d_state;
+       float d_lock_threshold;
+       int d_track_window;
+       int d_max_missed_frames;
+       int d_missed_frames;
+       uint64_t d_expected_frame;
+       std::vector<gr_complex> d_track_buf;
+       std::vector<gr_complex> d_track_cc;
+       std::vector<float> d_track_cc_abs;
+       float d_autocorr_threshold;
+       int d_search_window;
+       float d_frame_autocorr_metric;
+       float d_frame_xcorr_metric;
+       float d_frame_cfo;
+       float d_frame_snr_db;
+       int d_frame_timing_offset;
+
+       boost::atomic<uint64_t> d_frames_detected;
+       boost::atomic<uint64_t> d_frames_missed;
+       boost::atomic<uint64_t> d_locks_acquired;
+       boost::atomic<uint64_t> d_locks_lost;
+       boost::atomic<uint64_t> d_idle_blocks;
+       boost::atomic<uint64_t> d_autocorr_lags;
+       boost::atomic<uint64_t> d_xcorr_lags;
 
+       pmt::pmt_t d_gfdm_tag_key_pmt;
+       pmt::pmt_t d_lock_tag_key;
+       pmt::pmt_t d_cfo_tag_key;
+       pmt::pmt_t d_timing_tag_key;
+       pmt::pmt_t d_metric_tag_key;
+       pmt::pmt_t d_snr_tag_key;
+       pmt::pmt_t d_sync_port;
+       float d_energy_threshold_db;
+       float d_energy_threshold;
+       float d_noise_floor;
+       float d_noise_floor_alpha;
+       std::vector<float> d_gate_energy;
+
+       struct search_window_t { int first; int last; int candidate; };
+       
+       void integrate_plateau( float out[], const float start[], int num_items);
+       void window_energy( float out[], const gr_complex start[], int window_len, int num_items);
+       void find_candidates(std::vector<search_window_t>& windows, const float metric[], const float plateau[]);
+       bool channel_idle(const gr_complex samples[], float& mean_power);
+       void update_noise_floor(float mean_power, bool idle);
+
+       int search(gr_vector_void_star &output_items, const gr_complex in[]);
+       int track(gr_vector_void_star &output_items, const gr_complex samples[], int n_lags, int max_consume);
+       void set_frame_metrics(float autocorr_metric, float xcorr_metric, float cfo, int timing_offset);
+       void frame_detected(int offset, int nports);
+       void set_locked(bool locked, int offset, int nports);
 
      public:
-      sync_cc_impl(int sync_fft_len, int cp_length, int fft_len, gr::gfdm::preamble_generator_sptr preamble_generator, const std::string& gfdm_tag_key);
+      sync_cc_impl(int sync_fft_len, int cp_length, int fft_len, gr::gfdm::preamble_generator_sptr preamble_generator, const std::string& gfdm_tag_key, float lock_threshold, int track_window, float autocorr_threshold, int search_window, float energy_threshold_db);
       ~sync_cc_impl();
 
+      void set_lock_threshold(float lock_threshold);
+      float lock_threshold() const {return d_lock_threshold;}
+      void set_track_window(int track_window);
+      int track_window() const {return d_track_window;}
+      void set_max_missed_frames(int max_missed_frames);
+      int max_missed_frames() const {return d_max_missed_frames;}
+      void set_autocorr_threshold(float autocorr_threshold);
+      float autocorr_threshold() const {return d_autocorr_threshold;}
+      void set_search_window(int search_window);
+      int search_window() const {return d_search_window;}
+      void set_energy_threshold_db(float energy_threshold_db);
+      float energy_threshold_db() const {return d_energy_threshold_db;}
+      float noise_floor() const {return d_noise_floor;}
+      bool locked() const {return d_state == STATE_TRACK;}
+
+      float frame_autocorr_metric() const {return d_frame_autocorr_metric;}
+      float frame_xcorr_metric() const {return d_frame_xcorr_metric;}
+      float frame_cfo() const {return d_frame_cfo;}
+      float frame_snr_db() const {return d_frame_snr_db;}
+      int frame_timing_offset() const {return d_frame_timing_offset;}
+
+      uint64_t frames_detected() const {return d_frames_detected.load(boost::memory_order_relaxed);}
+      uint64_t frames_missed() const {return d_frames_missed.load(boost::memory_order_relaxed);}
+      uint64_t locks_acquired() const {return d_locks_acquired.load(boost::memory_order_relaxed);}
+      uint64_t locks_lost() const {return d_locks_lost.load(boost::memory_order_relaxed);}
+      uint64_t idle_blocks() const {return d_idle_blocks.load(boost::memory_order_relaxed);}
+      uint64_t autocorr_lags() const {return d_autocorr_lags.load(boost::memory_order_relaxed);}
+      uint64_t xcorr_lags() const {return d_xcorr_lags.load(boost::memory_order_relaxed);}
+
       // Where all the action really happens
       void forecast (int noutput_items, gr_vector_int &ninput_items_required);
 
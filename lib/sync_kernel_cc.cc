@@ -0,0 +1,137 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2016 Andrej Rode.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#include <gfdm/sync_kernel_cc.h>
+#include <volk/volk.h>
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+
+namespace gr {
+  namespace gfdm {
+
+    sync_kernel_cc::sync_kernel_cc(preamble_generator_sptr preamble_generator, int max_lags)
+      : d_preamble_len(preamble_generator->get_preamble_len()),
+        d_L(d_preamble_len / 2),
+        d_autocorr_block_len(256),
+        d_preamble(preamble_generator->get_preamble())
+    {
+      if(d_preamble_len < 2 || max_lags < 1){
+        throw std::invalid_argument("preamble_len must be at least 2 and max_lags positive");
+      }
+      gfdm_complex preamble_energy;
+      volk_32fc_x2_conjugate_dot_prod_32fc(&preamble_energy, &d_preamble[0], &d_preamble[0], d_preamble_len);
+      d_preamble_energy = std::real(preamble_energy);
+
+      const int corr_fft_len = preamble_correlator_cc::suggest_fft_len(d_preamble_len, max_lags);
+      d_correlator = preamble_correlator_cc::sptr(
+          new preamble_correlator_cc(d_preamble_len, preamble_generator->get_preamble_spectrum(corr_fft_len)));
+      // Direct dot products beat one overlap-save hop (two FFTs) for short windows
+      int log2_fft_len = 0;
+      while((1 << log2_fft_len) < d_correlator->fft_len()){
+        log2_fft_len++;
+      }
+      d_direct_max_lags = 2 * d_correlator->fft_len() * log2_fft_len / d_preamble_len;
+    }
+
+    sync_kernel_cc::~sync_kernel_cc()
+    {
+    }
+
+    void
+    sync_kernel_cc::autocorrelate(gfdm_complex* p_out, const gfdm_complex* p_in, int num_items)
+    {
+      // Lag-L products and their L-spaced differences are vectorized. The running sum over the
+      // differences is a blocked two-pass scan: pass 1 builds partial sums inside every block with
+      // the blocks advanced in lockstep, so the adds of one step are independent of each other.
+      // Pass 2 adds the carry of each block, an exact dot product, which also bounds the drift.
+      d_autocorr_products.resize(num_items + d_L - 1);
+      d_autocorr_diff.resize(num_items);
+      volk_32fc_x2_multiply_conjugate_32fc(&d_autocorr_products[0], &p_in[d_L], &p_in[0], num_items + d_L - 1);
+      if(num_items > 1){
+        volk_32f_x2_subtract_32f((float*) &d_autocorr_diff[0], (const float*) &d_autocorr_products[d_L],
+                                 (const float*) &d_autocorr_products[0], 2 * (num_items - 1));
+      }
+      const int B = d_autocorr_block_len;
+      const int n_full = num_items / B;
+      const int n_blocks = (num_items + B - 1) / B;
+      for(int b = 0; b < n_blocks; b++){
+        p_out[b * B] = gfdm_complex(0.0f, 0.0f);
+      }
+      for(int j = 1; j < B; j++){
+        for(int b = 0; b < n_full; b++){
+          p_out[b * B + j] = p_out[b * B + j - 1] + d_autocorr_diff[b * B + j - 1];
+        }
+      }
+      for(int i = n_full * B + 1; i < num_items; i++){
+        p_out[i] = p_out[i - 1] + d_autocorr_diff[i - 1];
+      }
+      d_autocorr_carry.resize(n_blocks);
+      for(int b = 0; b < n_blocks; b++){
+        volk_32fc_x2_conjugate_dot_prod_32fc(&d_autocorr_carry[b], &p_in[b * B + d_L], &p_in[b * B], d_L);
+      }
+      const float scale = 1.0f / d_L;
+      for(int b = 0; b < n_blocks; b++){
+        const int block_end = std::min((b + 1) * B, num_items);
+        const gfdm_complex carry = d_autocorr_carry[b];
+        for(int i = b * B; i < block_end; i++){
+          p_out[i] = (p_out[i] + carry) * scale;
+        }
+      }
+    }
+
+    void
+    sync_kernel_cc::correlate_window(gfdm_complex* p_out, const gfdm_complex* p_in, int n_lags)
+    {
+      if(n_lags > d_direct_max_lags){
+        d_correlator->generic_work(p_out, p_in, n_lags);
+        return;
+      }
+      for(int i = 0; i < n_lags; i++){
+        volk_32fc_x2_conjugate_dot_prod_32fc(&p_out[i], &p_in[i], &d_preamble[0], d_preamble_len);
+      }
+      volk_32fc_s32fc_multiply_32fc(&p_out[0], &p_out[0], gfdm_complex(1.0f / d_preamble_len, 0), n_lags);
+    }
+
+    float
+    sync_kernel_cc::autocorr_metric(const gfdm_complex* p_in, float& cfo)
+    {
+      // P = sum conj(x[n]) * x[n+L], R = sum |x[n+L]|^2
+      gfdm_complex autocorr;
+      gfdm_complex energy;
+      volk_32fc_x2_conjugate_dot_prod_32fc(&autocorr, &p_in[d_L], &p_in[0], d_L);
+      volk_32fc_x2_conjugate_dot_prod_32fc(&energy, &p_in[d_L], &p_in[d_L], d_L);
+      cfo = std::arg(autocorr) / M_PI;
+      return std::real(energy) > 0.0f ? std::abs(autocorr) / std::real(energy) : 0.0f;
+    }
+
+    float
+    sync_kernel_cc::normalized_metric(const gfdm_complex& cc, const gfdm_complex* p_in)
+    {
+      // |sum conj(p)*x| / sqrt(sum |p|^2 * sum |x|^2), cc is already divided by preamble_len
+      gfdm_complex energy;
+      volk_32fc_x2_conjugate_dot_prod_32fc(&energy, &p_in[0], &p_in[0], d_preamble_len);
+      const float norm = std::sqrt(d_preamble_energy * std::real(energy));
+      return norm > 0.0f ? d_preamble_len * std::abs(cc) / norm : 0.0f;
+    }
+
+  } /* namespace gfdm */
+} /* namespace gr */
@@ -29,17 +29,38 @@
 
 #include <gnuradio/unittests.h>
 #include "qa_gfdm.h"
+#include "qa_kernel_perf.h"
 #include <iostream>
 #include <fstream>
+#include <cstdlib>
+#include <string>
 
+/*
+ * test-gfdm                                    unit and golden vector tests
+ * test-gfdm --perf <baseline> [tolerance]      kernel timing regression against baseline
+ * test-gfdm --perf-record <baseline>           (re)write baseline from this machine
+ */
 int
 main (int argc, char **argv)
 {
+  const std::string mode = (argc > 1) ? argv[1] : "";
+  const bool perf = (mode == "--perf" || mode == "--perf-record");
+  if (perf && argc < 3) {
+    std::cerr << "usage: " << argv[0] << " --perf <baseline> [tolerance] | --perf-record <baseline>" << std::endl;
+    return 1;
+  }
+
   CppUnit::TextTestRunner runner;
-  std::ofstream xmlfile(get_unittest_path("gfdm.xml").c_str());
+  std::ofstream xmlfile(get_unittest_path(perf ? "gfdm_perf.xml" : "gfdm.xml").c_str());
   CppUnit::XmlOutputter *xmlout = new CppUnit::XmlOutputter(&runner.result(), xmlfile);
 
-  runner.addTest(qa_gfdm::suite());
+  if (perf) {
+    const double tolerance = (argc > 3) ? std::atof(argv[3]) : 0.25;
+    gr::gfdm::qa_kernel_perf::configure(argv[2], tolerance, mode == "--perf-record");
+    runner.addTest(qa_gfdm::perf_suite());
+  } else {
+    runner.addTest(qa_gfdm::suite());
+  }
   runner.setOutputter(xmlout);
 
   bool was_successful = runner.run("", false);
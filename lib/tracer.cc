@@ -0,0 +1,218 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2016 Andrej Rode.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <gfdm/tracer.h>
+#include <gfdm/stage_timers.h>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/tss.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <vector>
+#ifdef __linux__
+#include <sys/prctl.h>
+#endif
+
+namespace gr {
+  namespace gfdm {
+
+    namespace {
+      struct trace_event
+      {
+        const char* name;
+        double start_us;
+        double end_us;
+        int64_t frames;
+      };
+
+      // Single producer ring, only the owning thread writes events and head.
+      struct trace_ring
+      {
+        int tid;
+        std::string thread_name;
+        uint64_t mask;
+        std::vector<trace_event> events;
+        boost::atomic<uint64_t> head;
+        boost::atomic<uint64_t> floor;
+      };
+
+      void keep_ring(trace_ring*){}
+
+      boost::mutex s_rings_mutex;
+      std::vector<trace_ring*> s_rings;
+      boost::thread_specific_ptr<trace_ring> s_local_ring(&keep_ring);
+      int s_events_per_thread = 1 << 16;
+      const uint64_t s_epoch = stage_timers::monotonic_ns();
+
+      trace_ring*
+      register_thread()
+      {
+        trace_ring* r = new trace_ring();
+        uint64_t capacity = 1;
+        {
+          boost::mutex::scoped_lock guard(s_rings_mutex);
+          while(capacity < uint64_t(s_events_per_thread)){
+            capacity <<= 1;
+          }
+          r->tid = s_rings.size() + 1;
+          s_rings.push_back(r);
+        }
+        r->mask = capacity - 1;
+        r->events.resize(capacity);
+        r->head.store(0);
+        r->floor.store(0);
+#ifdef __linux__
+        // GNU Radio names its thread-per-block threads after the block.
+        char name[17] = {0};
+        if(prctl(PR_GET_NAME, name, 0, 0, 0) == 0){
+          r->thread_name = name;
+        }
+#endif
+        s_local_ring.reset(r);
+        return r;
+      }
+    }
+
+    boost::atomic<bool> tracer::s_enabled(false);
+
+    void
+    tracer::enable(int events_per_thread)
+    {
+      {
+        boost::mutex::scoped_lock guard(s_rings_mutex);
+        s_events_per_thread = std::max(events_per_thread, 2);
+      }
+      s_enabled.store(true);
+    }
+
+    void
+    tracer::disable()
+    {
+      s_enabled.store(false);
+    }
+
+    double
+    tracer::now_us()
+    {
+      return 1e-3 * double(stage_timers::monotonic_ns() - s_epoch);
+    }
+
+    void
+    tracer::record(const char* name, double start_us, double end_us, int64_t frames)
+    {
+      trace_ring* r = s_local_ring.get();
+      if(!r){
+        r = register_thread();
+      }
+      const uint64_t h = r->head.load(boost::memory_order_relaxed);
+      trace_event& e = r->events[h & r->mask];
+      e.name = name;
+      e.start_us = start_us;
+      e.end_us = end_us;
+      e.frames = frames;
+      r->head.store(h + 1, boost::memory_order_release);
+    }
+
+    void
+    tracer::clear()
+    {
+      boost::mutex::scoped_lock guard(s_rings_mutex);
+      for(size_t i = 0; i < s_rings.size(); i++){
+        s_rings[i]->floor.store(s_rings[i]->head.load());
+      }
+    }
+
+    bool
+    tracer::dump(const std::string& filename)
+    {
+      std::stringstream ss;
+      ss.precision(3);
+      ss << std::fixed << "{\"traceEvents\": [";
+      bool first = true;
+
+      boost::mutex::scoped_lock guard(s_rings_mutex);
+      for(size_t i = 0; i < s_rings.size(); i++){
+        trace_ring* r = s_rings[i];
+        const uint64_t capacity = r->mask + 1;
+        const uint64_t head = r->head.load(boost::memory_order_acquire);
+        uint64_t lo = std::max(r->floor.load(), head > capacity ? head - capacity : 0);
+        std::vector<trace_event> copy;
+        for(uint64_t n = lo; n < head; n++){
+          copy.push_back(r->events[n & r->mask]);
+        }
+        // the owner may have lapped us while copying, those slots are torn.
+        boost::atomic_thread_fence(boost::memory_order_acquire);
+        const uint64_t head_after = r->head.load(boost::memory_order_relaxed);
+        const uint64_t valid_from = head_after >= capacity ? head_after - capacity + 1 : 0;
+
+        ss << (first ? "\n" : ",\n");
+        first = false;
+        ss << "  {\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << r->tid
+           << ", \"args\": {\"name\": \"" << (r->thread_name.empty() ? "gfdm" : r->thread_name.c_str()) << "\"}}";
+        for(uint64_t n = std::max(lo, valid_from); n < head; n++){
+          const trace_event& e = copy[n - lo];
+          ss << ",\n  {\"name\": \"" << e.name << "\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << r->tid
+             << ", \"ts\": " << e.start_us << ", \"dur\": " << e.end_us - e.start_us;
+          if(e.frames >= 0){
+            ss << ", \"args\": {\"frames\": " << e.frames << "}";
+          }
+          ss << "}";
+        }
+      }
+      ss << "\n], \"displayTimeUnit\": \"ns\"}\n";
+
+      FILE* fp = fopen(filename.c_str(), "w");
+      if(fp == 0){
+        return false;
+      }
+      const std::string json = ss.str();
+      fwrite(json.data(), 1, json.size(), fp);
+      fclose(fp);
+      return true;
+    }
+
+    namespace {
+      // GFDM_TRACE=<file.json> traces the whole process and dumps at exit.
+      struct trace_from_environment
+      {
+        std::string filename;
+        trace_from_environment()
+        {
+          const char* env = getenv("GFDM_TRACE");
+          if(env != 0 && env[0] != '\0'){
+            filename = env;
+            tracer::enable();
+          }
+        }
+        ~trace_from_environment()
+        {
+          if(!filename.empty()){
+            tracer::disable();
+            tracer::dump(filename);
+          }
+        }
+      };
+      trace_from_environment s_trace_from_environment;
+    }
+
+  } /* namespace gfdm */
+} /* namespace gr */
+
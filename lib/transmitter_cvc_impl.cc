@@ -24,6 +24,7 @@
 
 #include <gnuradio/io_signature.h>
 #include "transmitter_cvc_impl.h"
+#include <gfdm/fft_plan.h>
 
 namespace gr {
   namespace gfdm {
@@ -68,17 +69,19 @@ namespace gr {
 			    filter_alpha,
 			    d_N);
              
-            // Initialize filter FFT 
-            fft::fft_real_fwd *filter_fft = new fft::fft_real_fwd(d_N,1);
-            float *in = filter_fft->get_inbuf();
-            gr_complex *out = filter_fft->get_outbuf();
+            // Real filtertaps go through a complex FFT
+            std::vector<gr_complex> in(d_N);
+            std::vector<gr_complex> out(d_N);
 
             // Copy Filtertaps in FFT Input
             for (int i=0;i<d_N;i++)
             {
               in[i] = filtertaps[mod(i-(d_N)/2,d_N)];
             }
-            filter_fft->execute();
+            {
+              fft_plan filter_fft(d_N, &in[0], &out[0], true);
+              filter_fft.execute();
+            }
 
             // filter_width*d_ntimeslots must be power of 2
             // Real-valued FFT is symmetrical in f=0
@@ -93,17 +96,16 @@ namespace gr {
             {
               d_filtertaps.push_back(out[i]);
             }
-            delete filter_fft;
             
             // Initialize FFT per subcarrier
-            d_sc_fft = new fft::fft_complex(d_ntimeslots,true,1);
-            d_sc_fft_in = d_sc_fft->get_inbuf();
-            d_sc_fft_out = d_sc_fft->get_outbuf();
+            d_sc_fft_in = (gr_complex*) volk_malloc(sizeof(gr_complex) * d_ntimeslots, volk_get_alignment());
+            d_sc_fft_out = (gr_complex*) volk_malloc(sizeof(gr_complex) * d_ntimeslots, volk_get_alignment());
+            d_sc_fft = new fft_plan(d_ntimeslots, d_sc_fft_in, d_sc_fft_out, true);
             
             // Initialize resulting IFFT 
-            d_out_ifft = new fft::fft_complex(d_ntimeslots*d_nsubcarrier,false,1);
-            d_out_ifft_in = d_out_ifft->get_inbuf();
-            d_out_ifft_out = d_out_ifft->get_outbuf();
+            d_out_ifft_in = (gr_complex*) volk_malloc(sizeof(gr_complex) * d_N, volk_get_alignment());
+            d_out_ifft_out = (gr_complex*) volk_malloc(sizeof(gr_complex) * d_N, volk_get_alignment());
+            d_out_ifft = new fft_plan(d_N, d_out_ifft_in, d_out_ifft_out, false);
 
     }
 
@@ -113,7 +115,11 @@ namespace gr {
     transmitter_cvc_impl::~transmitter_cvc_impl()
     {
       delete d_sc_fft;
+      volk_free(d_sc_fft_in);
+      volk_free(d_sc_fft_out);
       delete d_out_ifft;
+      volk_free(d_out_ifft_in);
+      volk_free(d_out_ifft_out);
     }
 
     std::vector<gr_complex>
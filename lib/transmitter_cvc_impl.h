@@ -22,7 +22,8 @@
 #define INCLUDED_GFDM_TRANSMITTER_CVC_IMPL_H
 
 #include <gfdm/transmitter_cvc.h>
-#include <gnuradio/fft/fft.h>
+#include <gfdm/fft_plan.h>
+#include <volk/volk.h>
 #include <gnuradio/filter/firdes.h>
 
 namespace gr {
@@ -37,10 +38,10 @@ namespace gr {
        std::vector<gr_complex> d_filtertaps;
        int d_symbols_per_set;
        int d_filter_width;
-       fft::fft_complex *d_sc_fft;
+       fft_plan *d_sc_fft;
        gr_complex * d_sc_fft_in;
        gr_complex * d_sc_fft_out;
-       fft::fft_complex *d_out_ifft;
+       fft_plan *d_out_ifft;
        gr_complex * d_out_ifft_in;
        gr_complex * d_out_ifft_out;
        int mod(int k, int n);
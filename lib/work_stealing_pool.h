@@ -0,0 +1,170 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2016 Andrej Rode.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_GFDM_WORK_STEALING_POOL_H
+#define INCLUDED_GFDM_WORK_STEALING_POOL_H
+
+/*
+ * Header-only thread pool of gfdm_ber_sim, tested in test-gfdm.
+ */
+
+#include <boost/bind.hpp>
+#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <deque>
+#include <vector>
+
+namespace gr {
+  namespace gfdm {
+
+    /*!
+     * Thread pool where every worker runs tasks from its own deque, newest
+     * first, and steals the oldest task of another worker once its own deque
+     * is empty.
+     */
+    class work_stealing_pool
+    {
+    public:
+      //! A task gets the index of the worker running it.
+      typedef boost::function<void (int)> task_t;
+
+      work_stealing_pool(int nthreads)
+        : d_queued(0), d_pending(0), d_stop(false)
+      {
+        for(int i = 0; i < nthreads; i++){
+          d_queues.push_back(boost::shared_ptr<queue_t>(new queue_t));
+        }
+        for(int i = 0; i < nthreads; i++){
+          d_threads.create_thread(boost::bind(&work_stealing_pool::run, this, i));
+        }
+      }
+
+      ~work_stealing_pool()
+      {
+        {
+          boost::mutex::scoped_lock lock(d_mutex);
+          d_stop = true;
+        }
+        d_work.notify_all();
+        d_threads.join_all();
+      }
+
+      int size() const { return d_queues.size();};
+
+      //! Queue task on the deque of worker, e.g. the one a task runs on.
+      void
+      submit(const task_t& task, int worker)
+      {
+        // count before the task becomes visible, a worker may steal and finish it right away.
+        {
+          boost::mutex::scoped_lock lock(d_mutex);
+          d_queued++;
+          d_pending++;
+        }
+        {
+          boost::mutex::scoped_lock lock(d_queues[worker]->mutex);
+          d_queues[worker]->tasks.push_back(task);
+        }
+        d_work.notify_one();
+      }
+
+      //! Block until all tasks, including the ones submitted by tasks, have run.
+      void
+      wait()
+      {
+        boost::mutex::scoped_lock lock(d_mutex);
+        while(d_pending > 0){
+          d_idle.wait(lock);
+        }
+      }
+
+    private:
+      struct queue_t {
+        boost::mutex mutex;
+        std::deque<task_t> tasks;
+      };
+
+      std::vector<boost::shared_ptr<queue_t> > d_queues;
+      boost::thread_group d_threads;
+      boost::mutex d_mutex;
+      boost::condition_variable d_work;
+      boost::condition_variable d_idle;
+      long d_queued;   // tasks in the deques
+      long d_pending;  // tasks submitted but not finished
+      bool d_stop;
+
+      bool
+      pop(int worker, task_t& task)
+      {
+        const int n = size();
+        for(int i = 0; i < n; i++){
+          queue_t& q = *d_queues[(worker + i) % n];
+          boost::mutex::scoped_lock lock(q.mutex);
+          if(q.tasks.empty()){
+            continue;
+          }
+          if(i == 0){
+            task = q.tasks.back();
+            q.tasks.pop_back();
+          }
+          else{
+            task = q.tasks.front();
+            q.tasks.pop_front();
+          }
+          return true;
+        }
+        return false;
+      }
+
+      void
+      run(int worker)
+      {
+        for(;;){
+          task_t task;
+          if(pop(worker, task)){
+            {
+              boost::mutex::scoped_lock lock(d_mutex);
+              d_queued--;
+            }
+            task(worker);
+            boost::mutex::scoped_lock lock(d_mutex);
+            if(--d_pending == 0){
+              d_idle.notify_all();
+            }
+            continue;
+          }
+          boost::mutex::scoped_lock lock(d_mutex);
+          while(d_queued == 0 && !d_stop){
+            d_work.wait(lock);
+          }
+          if(d_queued == 0){
+            return;
+          }
+        }
+      }
+    };
+
+  } // namespace gfdm
+} // namespace gr
+
+#endif /* INCLUDED_GFDM_WORK_STEALING_POOL_H */
@@ -0,0 +1,82 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# 
+# Copyright 2016 Andrej Rode.
+# 
+# This is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+# 
+# This software is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+# 
+# You should have received a copy of the GNU General Public License
+# along with this software; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+
+from gnuradio import gr_unittest
+import gfdm_swig as gfdm
+from pygfdm.filters import get_frequency_domain_filter
+from pygfdm.gfdm_modulation import gfdm_modulate_block
+from pygfdm.mapping import get_data_matrix
+from pygfdm.utils import get_random_qpsk
+import numpy as np
+
+
+class qa_batch_kernels(gr_unittest.TestCase):
+    def test_001_modulate(self):
+        alpha = .5
+        M = 8
+        K = 4
+        L = 2
+        n_frames = 5
+        taps = get_frequency_domain_filter('rrc', alpha, M, K, L)
+        data = np.zeros((n_frames, M * K), dtype=np.complex64)
+        ref = np.zeros((n_frames, M * K), dtype=np.complex64)
+        for i in range(n_frames):
+            data[i] = get_random_qpsk(M * K)
+            D = get_data_matrix(data[i], K, group_by_subcarrier=False)
+            ref[i] = gfdm_modulate_block(D, taps, M, K, L, False)
+
+        for nthreads in (1, 3):
+            mod = gfdm.batch_modulator(M, K, L, taps, nthreads)
+            res = mod.modulate(data)
+            self.assertComplexTuplesAlmostEqual(ref.flatten(), res.flatten(), 5)
+
+            buf = data.copy()
+            res = mod.modulate(buf, out=buf)
+            self.assertTrue(res is buf)
+            self.assertComplexTuplesAlmostEqual(ref.flatten(), buf.flatten(), 5)
+
+    def test_002_demodulate_threads(self):
+        M = 5
+        K = 16
+        fft_len = 96
+        n_frames = 6
+        points = np.array([1 + 1j, -1 + 1j, -1 - 1j, 1 - 1j]) / np.sqrt(2.)
+        samples = (np.random.randn(n_frames, fft_len) + 1j * np.random.randn(n_frames, fft_len)).astype(np.complex64)
+
+        ref = gfdm.batch_receiver(K, M, .35, fft_len, 1).demodulate_ic(samples, 2, points)
+        res = gfdm.batch_receiver(K, M, .35, fft_len, 3).demodulate_ic(samples, 2, points)
+        self.assertEqual((n_frames, M * K), res.shape)
+        self.assertComplexTuplesAlmostEqual(ref.flatten(), res.flatten(), 5)
+
+    def test_003_rejects_copies(self):
+        M = 5
+        K = 16
+        rx = gfdm.batch_receiver(K, M, .35, M * K, 1)
+        samples = np.zeros((2, M * K), dtype=np.complex64)
+        # converting would copy, so the caller has to do it.
+        self.assertRaises(TypeError, rx.demodulate, samples.astype(np.complex128))
+        self.assertRaises(ValueError, rx.demodulate, np.zeros((M * K, 2), dtype=np.complex64).T)
+        self.assertRaises(ValueError, rx.demodulate, samples, np.zeros((3, M * K), dtype=np.complex64))
+
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_batch_kernels)
@@ -23,7 +23,7 @@ from gnuradio import gr, gr_unittest
 from gnuradio import blocks
 import gfdm_swig as gfdm
 import numpy as np
-from pygfdm.cyclic_prefix import add_cyclic_prefix, pinch_block, get_raised_cosine_ramp, get_window_len
+from pygfdm.cyclic_prefix import add_cyclic_prefix, add_cyclic_starfix, pinch_block, get_raised_cosine_ramp, get_window_len
 
 
 class qa_cyclic_prefixer_cc(gr_unittest.TestCase):
@@ -86,6 +86,34 @@ class qa_cyclic_prefixer_cc(gr_unittest.TestCase):
 
         self.assertComplexTuplesAlmostEqual(res, ref, 4)
 
+    def test_004_cyclic_suffix_overlap(self):
+        n_frames = 20
+        n_subcarriers = 8
+        n_timeslots = 8
+        block_len = n_subcarriers * n_timeslots
+        cp_len = 8
+        ramp_len = 4
+        frame_len = block_len + cp_len
+        window_len = get_window_len(cp_len + ramp_len, n_timeslots, n_subcarriers)
+        window_taps = get_raised_cosine_ramp(ramp_len, window_len)
+        data = np.random.randn(n_frames * block_len) + 1j * np.random.randn(n_frames * block_len)
+
+        ref = np.zeros(n_frames * frame_len + ramp_len, dtype=np.complex)
+        for i in range(n_frames):
+            b = data[i * block_len:(i + 1) * block_len]
+            f = pinch_block(add_cyclic_starfix(b, cp_len, ramp_len), window_taps)
+            ref[i * frame_len:(i + 1) * frame_len + ramp_len] += f
+        ref = ref[0:n_frames * frame_len]
+
+        prefixer = gfdm.cyclic_prefixer_cc(cp_len, ramp_len, block_len, window_taps, True)
+        src = blocks.vector_source_c(data)
+        dst = blocks.vector_sink_c()
+        self.tb.connect(src, prefixer, dst)
+        self.tb.run()
+
+        res = np.array(dst.data())
+        self.assertComplexTuplesAlmostEqual(res, ref, 4)
+
 
 if __name__ == '__main__':
     # gr_unittest.run(qa_cyclic_prefixer_cc, "qa_cyclic_prefixer_cc.xml")
@@ -0,0 +1,141 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2016 <+YOU OR YOUR COMPANY+>.
+#
+# This is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+#
+# This software is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this software; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+
+from gnuradio import gr, gr_unittest
+from gnuradio import blocks, digital
+import gfdm_swig as gfdm
+from pygfdm.filters import get_frequency_domain_filter
+from pygfdm.utils import get_random_qpsk
+from pygfdm.cyclic_prefix import get_window_len, get_raised_cosine_ramp
+import numpy as np
+
+
+class qa_frame_receiver_cc(gr_unittest.TestCase):
+
+    def setUp(self):
+        np.random.seed(0)
+        self.tb = gr.top_block()
+        self.n_timeslots = 16
+        self.n_subcarriers = 16
+        self.overlap = 2
+        self.alpha = .2
+        self.cp_len = 16
+        self.ramp_len = 4
+        self.sync_len = 64
+        self.fft_len = self.n_timeslots * self.n_subcarriers
+        self.block_len = 2 * self.cp_len + self.sync_len + self.fft_len
+        self.preamble_generator = gfdm.preamble_generator(self.sync_len // 2, self.alpha, self.sync_len)
+        self.constellation = digital.constellation_qpsk().base()
+
+    def tearDown(self):
+        self.tb = None
+
+    def transmit(self, data, lead=128, noise=1e-3):
+        '''
+            frame_transmitter_cc output in weak noise, with lead samples in
+            front and half a frame behind the last one.
+            Unit QPSK data gives GFDM blocks far stronger than the preamble,
+            data is scaled by .05 to bring both to about the same power.
+        '''
+        taps = get_frequency_domain_filter('rrc', self.alpha, self.n_timeslots, self.n_subcarriers, self.overlap)
+        window_taps = get_raised_cosine_ramp(self.ramp_len, get_window_len(self.cp_len, self.n_timeslots, self.n_subcarriers))
+        tx = gfdm.frame_transmitter_cc(self.n_timeslots, self.n_subcarriers, self.overlap, taps,
+                                       self.cp_len, self.ramp_len, window_taps, self.preamble_generator)
+        src = blocks.vector_source_c(.05 * data)
+        dst = blocks.vector_sink_c()
+        tb = gr.top_block()
+        tb.connect(src, tx, dst)
+        tb.run()
+        frames = np.array(dst.data())
+        samples = np.concatenate((np.zeros(lead), frames, np.zeros(self.block_len // 2)))
+        samples += noise * (np.random.randn(len(samples)) + 1j * np.random.randn(len(samples)))
+        return samples
+
+    def make_sync(self):
+        return gfdm.sync_cc(self.sync_len, self.cp_len, self.fft_len, self.preamble_generator)
+
+    def make_receiver(self, sync_messages=False):
+        return gfdm.frame_receiver_cc(self.n_subcarriers, self.n_timeslots, self.alpha, self.fft_len,
+                                      self.cp_len, self.sync_len, 0, self.constellation,
+                                      "gfdm_block", "gfdm_frame", sync_messages)
+
+    def test_001_sync_messages(self):
+        n_frames = 8
+        data = get_random_qpsk(n_frames * self.fft_len)
+        samples = self.transmit(data)
+
+        # frame starts from sync_cc stream tags
+        src = blocks.vector_source_c(samples)
+        sync = self.make_sync()
+        rx = self.make_receiver()
+        dst = blocks.vector_sink_c()
+        self.tb.connect(src, sync, rx, dst)
+        self.tb.run()
+        ref = dst.data()
+        self.assertEqual(len(ref), n_frames * self.fft_len)
+
+        # sync_cc only searches, the receiver reads the source itself
+        self.tb = gr.top_block()
+        src = blocks.vector_source_c(samples)
+        sync = self.make_sync()
+        rx = self.make_receiver(True)
+        dst = blocks.vector_sink_c()
+        self.tb.connect(src, sync)
+        self.tb.connect(src, rx, dst)
+        self.tb.msg_connect(sync, "sync", rx, "sync")
+        self.tb.run()
+
+        self.assertEqual(sync.frames_detected(), n_frames)
+        self.assertComplexTuplesAlmostEqual(ref, dst.data(), 6)
+        frame_tags = [gr.tag_to_python(t) for t in dst.tags()]
+        self.assertEqual([t.offset for t in frame_tags], range(0, n_frames * self.fft_len, self.fft_len))
+
+    def test_002_transmitter_chain(self):
+        n_frames = 8
+        data = get_random_qpsk(n_frames * self.fft_len)
+        samples = self.transmit(data)
+
+        # frame_receiver_cc expects subcarrier k centred (M - N) / 2 bins off the
+        # kM bin modulator_kernel_cc puts it on, shift the spectrum in between.
+        # The lead keeps the shift phase at zero on every data block.
+        shift = (self.n_timeslots - self.fft_len) // 2
+        src = blocks.vector_source_c(samples)
+        sync = self.make_sync()
+        rotator = blocks.rotator_cc(2. * np.pi * shift / self.fft_len)
+        # small chunks make frames straddle receiver calls
+        rotator.set_max_noutput_items(64)
+        rx = self.make_receiver()
+        dst = blocks.vector_sink_c()
+        self.tb.connect(src, sync, rotator, rx, dst)
+        self.tb.run()
+
+        self.assertEqual(sync.frames_detected(), n_frames)
+        res = np.array(dst.data())
+        self.assertEqual(len(res), len(data))
+        np.testing.assert_array_equal(np.sign(res.real), np.sign(data.real))
+        np.testing.assert_array_equal(np.sign(res.imag), np.sign(data.imag))
+        frame_tags = [gr.tag_to_python(t) for t in dst.tags()]
+        self.assertEqual([t.offset for t in frame_tags], range(0, n_frames * self.fft_len, self.fft_len))
+
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_frame_receiver_cc, "qa_frame_receiver_cc.xml")
@@ -0,0 +1,82 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2016 <+YOU OR YOUR COMPANY+>.
+#
+# This is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+#
+# This software is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this software; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+
+from gnuradio import gr, gr_unittest
+from gnuradio import blocks
+import gfdm_swig as gfdm
+from pygfdm.filters import get_frequency_domain_filter
+from pygfdm.utils import get_random_qpsk
+from pygfdm.cyclic_prefix import get_window_len, get_raised_cosine_ramp
+import numpy as np
+
+
+class qa_frame_transmitter_cc(gr_unittest.TestCase):
+    def setUp(self):
+        self.tb = gr.top_block()
+
+    def tearDown(self):
+        self.tb = None
+
+    def test_001_t(self):
+        n_frames = 5
+        alpha = .5
+        M = 8
+        K = 16
+        L = 2
+        cp_len = 16
+        ramp_len = 4
+        block_len = M * K
+        window_len = get_window_len(cp_len, M, K)
+        taps = get_frequency_domain_filter('rrc', alpha, M, K, L)
+        window_taps = get_raised_cosine_ramp(ramp_len, window_len)
+        preamble_generator = gfdm.preamble_generator(K, alpha, 2 * K)
+        preamble = np.array(preamble_generator.get_preamble())
+        preamble_part = np.concatenate((preamble[-cp_len:], preamble))
+        frame_len = len(preamble_part) + window_len
+
+        data = get_random_qpsk(n_frames * block_len)
+
+        # reference: the separate blocks with the [cp | preamble] part inserted in front of every block
+        framer = gfdm.framer_cc(K, M, False, [], preamble_generator)
+        mod = gfdm.simple_modulator_cc(M, K, L, taps)
+        prefixer = gfdm.cyclic_prefixer_cc(cp_len, ramp_len, block_len, window_taps)
+        preambler = blocks.vector_insert_c(preamble_part, frame_len, 0)
+        ref_dst = blocks.vector_sink_c()
+        self.tb.connect(blocks.vector_source_c(data), framer, mod, prefixer, preambler, ref_dst)
+
+        tx = gfdm.frame_transmitter_cc(M, K, L, taps, cp_len, ramp_len, window_taps, preamble_generator)
+        dst = blocks.vector_sink_c()
+        self.tb.connect(blocks.vector_source_c(data), tx, dst)
+        self.tb.run()
+
+        ref = np.array(ref_dst.data())[0:n_frames * frame_len]
+        res = np.array(dst.data())
+        self.assertEqual(len(res), n_frames * frame_len)
+        self.assertComplexTuplesAlmostEqual(ref, res, 5)
+
+        tags = [gr.tag_to_python(t) for t in dst.tags()]
+        frames = [(t.offset, t.value) for t in tags if t.key == "gfdm_frame"]
+        self.assertEqual(frames, [(i * frame_len, frame_len) for i in range(n_frames)])
+
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_frame_transmitter_cc)
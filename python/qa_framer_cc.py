@@ -22,64 +22,71 @@
 from gnuradio import gr, gr_unittest
 from gnuradio import blocks
 import numpy as np
-import gfdm.modulation as mod
-import gfdm_swig as gfdms
-from pprint import pprint
+import gfdm_swig as gfdm
+from pygfdm.mapping import reshape_input
+from pygfdm.utils import get_random_qpsk
+
 
 class qa_framer_cc (gr_unittest.TestCase):
 
     def setUp (self):
         self.tb = gr.top_block()
+        self.nsubcarrier = 16
+        self.ntimeslots = 8
+        self.block_len = self.nsubcarrier * self.ntimeslots
+        # several frames reach the framer in a single call
+        self.n_frames = 8
+        self.src_data = get_random_qpsk(self.n_frames * self.block_len)
 
     def tearDown (self):
         self.tb = None
 
-    def test_001_t (self):
-        nsubcarrier = 64
-        ntimeslots = 16
-        src_data = np.array([np.complex(np.random.choice([-1,1]),np.random.choice([-1,1])) for i in xrange(nsubcarrier*ntimeslots)])
-        src = blocks.vector_source_c(src_data,vlen=1)
-        stts = blocks.stream_to_tagged_stream(
-            gr.sizeof_gr_complex,vlen=1,
-            packet_len=nsubcarrier*ntimeslots,len_tag_key="frame_len")
-        fr = gfdms.framer_cc(nsubcarrier,ntimeslots,False,[],"frame_len")
-        dst = blocks.vector_sink_c(vlen=1)
-        expected_result = mod.reshape_input(src_data, ntimeslots, nsubcarrier)
-        self.tb.connect(src,stts)
-        self.tb.connect(stts,fr)
-        self.tb.connect(fr,dst)
+    def run_framer(self, fr):
+        src = blocks.vector_source_c(self.src_data)
+        dst = blocks.vector_sink_c()
+        self.tb.connect(src, fr, dst)
         self.tb.run()
-        result_data = dst.data()
-        tags = dst.tags()
-        for tag in tags:
-            ptag = gr.tag_to_python(tag)
-            pprint(vars(ptag))
-        self.assertComplexTuplesAlmostEqual(expected_result,result_data, 6)
+        tags = [gr.tag_to_python(t) for t in dst.tags()]
+        return np.array(dst.data()), tags
+
+    def expected(self, sync_symbols):
+        frames = [np.concatenate((sync_symbols, reshape_input(d, self.ntimeslots, self.nsubcarrier)))
+                  for d in np.split(self.src_data, self.n_frames)]
+        return np.concatenate(frames)
+
+    def check_tags(self, tags, sync_len):
+        frame_len = sync_len + self.block_len
+        starts = [i * frame_len for i in range(self.n_frames)]
+        frames = [(t.offset, t.value) for t in tags if t.key == "gfdm_frame"]
+        data = [(t.offset, t.value) for t in tags if t.key == "gfdm_data"]
+        sync = [(t.offset, t.value) for t in tags if t.key == "gfdm_sync"]
+        self.assertEqual(frames, [(s, frame_len) for s in starts])
+        self.assertEqual(data, [(s + sync_len, self.block_len) for s in starts])
+        if sync_len:
+            self.assertEqual(sync, [(s, sync_len) for s in starts])
+        else:
+            self.assertEqual(sync, [])
+
+    def test_001_t (self):
+        fr = gfdm.framer_cc(self.nsubcarrier, self.ntimeslots, False, [], gfdm.preamble_generator_sptr())
+        result_data, tags = self.run_framer(fr)
+        self.assertComplexTuplesAlmostEqual(self.expected([]), result_data, 6)
+        self.check_tags(tags, 0)
 
     def test_002_t (self):
-        nsubcarrier = 16
-        ntimeslots = 64
-        sync_data = np.array([np.complex(np.random.choice([-1,1]),np.random.choice([-1,1])) for i in xrange(nsubcarrier)])
-        src_data = np.array([np.complex(np.random.choice([-1,1]),np.random.choice([-1,1])) for i in xrange(nsubcarrier*ntimeslots)])
-        src = blocks.vector_source_c(src_data,vlen=1)
-        stts = blocks.stream_to_tagged_stream(
-            gr.sizeof_gr_complex,vlen=1,
-            packet_len=nsubcarrier*ntimeslots,len_tag_key="frame_len")
-        fr = gfdms.framer_cc(nsubcarrier,ntimeslots,True,sync_data,"frame_len")
-        dst = blocks.vector_sink_c(vlen=1)
-        expected_result = np.concatenate(
-            (mod.reshape_input(np.tile(sync_data,2),2,nsubcarrier),
-             mod.reshape_input(src_data, ntimeslots, nsubcarrier)))
-        self.tb.connect(src,stts)
-        self.tb.connect(stts,fr)
-        self.tb.connect(fr,dst)
-        self.tb.run()
-        result_data = dst.data()
-        tags = dst.tags()
-        for tag in tags:
-            ptag = gr.tag_to_python(tag)
-            pprint(vars(ptag))
-        self.assertComplexTuplesAlmostEqual(expected_result,result_data[0:nsubcarrier*ntimeslots+2*nsubcarrier],6)
+        sync_data = get_random_qpsk(2 * self.nsubcarrier)
+        fr = gfdm.framer_cc(self.nsubcarrier, self.ntimeslots, True, sync_data, gfdm.preamble_generator_sptr())
+        result_data, tags = self.run_framer(fr)
+        self.assertComplexTuplesAlmostEqual(self.expected(sync_data), result_data, 6)
+        self.check_tags(tags, len(sync_data))
+
+    def test_003_preamble_generator (self):
+        preamble_generator = gfdm.preamble_generator(self.nsubcarrier, .5, 2 * self.nsubcarrier)
+        preamble = np.array(preamble_generator.get_preamble())
+        fr = gfdm.framer_cc(self.nsubcarrier, self.ntimeslots, True, [], preamble_generator)
+        result_data, tags = self.run_framer(fr)
+        self.assertComplexTuplesAlmostEqual(self.expected(preamble), result_data, 6)
+        self.check_tags(tags, len(preamble))
 
 
 if __name__ == '__main__':
@@ -21,6 +21,7 @@
 
 from gnuradio import gr, gr_unittest
 from gnuradio import blocks
+import pmt
 import gfdm_swig as gfdm
 from pygfdm.filters import get_frequency_domain_filter
 from pygfdm.gfdm_modulation import gfdm_modulate_block
@@ -99,6 +100,28 @@ class qa_simple_modulator_cc(gr_unittest.TestCase):
 
         self.assertComplexTuplesAlmostEqual(ref, res, 2)
 
+    def test_003_stage_timing(self):
+        M = 8
+        K = 4
+        L = 2
+        n_frames = 3
+        taps = get_frequency_domain_filter('rrc', .5, M, K, L)
+        src = blocks.vector_source_c(get_random_qpsk(n_frames * M * K))
+        mod = gfdm.simple_modulator_cc(M, K, L, taps)
+        dst = blocks.vector_sink_c()
+
+        self.tb.connect(src, mod, dst)
+        self.tb.run()
+
+        # frames are counted even if the stages are not timed (ENABLE_STAGE_TIMERS off)
+        timing = mod.stage_timing()
+        self.assertEqual(pmt.to_uint64(pmt.dict_ref(timing, pmt.intern('frames'), pmt.PMT_NIL)), n_frames)
+        for stage in ('sub_fft', 'filter', 'ifft'):
+            self.assertTrue(pmt.dict_has_key(timing, pmt.intern(stage)))
+        mod.reset_stage_timing()
+        timing = mod.stage_timing()
+        self.assertEqual(pmt.to_uint64(pmt.dict_ref(timing, pmt.intern('frames'), pmt.PMT_NIL)), 0)
+
 
 if __name__ == '__main__':
     # gr_unittest.run(qa_simple_modulator_cc, "qa_simple_modulator_cc.xml")
@@ -1,40 +1,239 @@
 #!/usr/bin/env python
 # -*- coding: utf-8 -*-
-# 
+#
 # Copyright 2016 <+YOU OR YOUR COMPANY+>.
-# 
+#
 # This is free software; you can redistribute it and/or modify
 # it under the terms of the GNU General Public License as published by
 # the Free Software Foundation; either version 3, or (at your option)
 # any later version.
-# 
+#
 # This software is distributed in the hope that it will be useful,
 # but WITHOUT ANY WARRANTY; without even the implied warranty of
 # MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
 # GNU General Public License for more details.
-# 
+#
 # You should have received a copy of the GNU General Public License
 # along with this software; see the file COPYING.  If not, write to
 # the Free Software Foundation, Inc., 51 Franklin Street,
 # Boston, MA 02110-1301, USA.
-# 
+#
 
 from gnuradio import gr, gr_unittest
 from gnuradio import blocks
+import pmt
 import gfdm_swig as gfdm
+import numpy as np
+
+
+def frame_stream(preamble, cp_len, fft_len, sent, delays=None, lead=100, tail=None, noise=1e-3):
+    '''
+        Frames [CP|preamble][CP|QPSK data] back to back in weak noise.
+        sent: per frame slot, False leaves the slot empty
+        delays: extra samples inserted in front of each slot
+        returns samples and the preamble start of every slot
+    '''
+    sync_len = len(preamble)
+    block_len = 2 * cp_len + sync_len + fft_len
+    if delays is None:
+        delays = [0] * len(sent)
+    if tail is None:
+        tail = block_len // 2
+    scale = np.sqrt(np.mean(np.abs(preamble) ** 2) / 2.)
+    sync_block = np.concatenate((preamble[-cp_len:], preamble))
+    frames = []
+    starts = []
+    pos = lead
+    for s, d in zip(sent, delays):
+        pos += d
+        data = scale * ((2 * np.random.randint(0, 2, fft_len) - 1) + 1j * (2 * np.random.randint(0, 2, fft_len) - 1))
+        if s:
+            frames.append((pos, np.concatenate((sync_block, data[-cp_len:], data))))
+        starts.append(pos + cp_len)
+        pos += block_len
+    samples = noise * (np.random.randn(pos + tail) + 1j * np.random.randn(pos + tail))
+    for p, b in frames:
+        samples[p:p + block_len] += b
+    return samples, starts
+
 
 class qa_sync_cc (gr_unittest.TestCase):
 
     def setUp (self):
+        np.random.seed(0)
         self.tb = gr.top_block ()
+        self.sync_len = 64
+        self.cp_len = 16
+        self.fft_len = 256
+        self.block_len = 2 * self.cp_len + self.sync_len + self.fft_len
+        self.preamble_generator = gfdm.preamble_generator(self.sync_len // 2, .5, self.sync_len)
+        self.preamble = np.array(self.preamble_generator.get_preamble())
 
     def tearDown (self):
         self.tb = None
 
-    def test_001_t (self):
-        # set up fg
-        self.tb.run ()
-        # check data
+    def make_sync(self, lock_threshold=.6, track_window=8, energy_threshold_db=0.):
+        return gfdm.sync_cc(self.sync_len, self.cp_len, self.fft_len, self.preamble_generator,
+                            "gfdm_block", lock_threshold, track_window, .5, 16, energy_threshold_db)
+
+    def run_sync(self, sync, samples):
+        src = blocks.vector_source_c(samples)
+        dst = blocks.vector_sink_c()
+        self.tb.connect(src, sync, dst)
+        self.tb.run()
+        self.assertComplexTuplesAlmostEqual(samples[0:len(dst.data())], dst.data(), 6)
+        tags = [gr.tag_to_python(t) for t in dst.tags()]
+        frames = [t.offset for t in tags if t.key == "gfdm_block"]
+        locks = [(t.offset, t.value) for t in tags if t.key == "gfdm_sync_lock"]
+        timing = [t.value for t in tags if t.key == "gfdm_timing_offset"]
+        return frames, locks, timing
+
+    def test_001_lock(self):
+        samples, starts = frame_stream(self.preamble, self.cp_len, self.fft_len, [True] * 6)
+        sync = self.make_sync()
+        frames, locks, timing = self.run_sync(sync, samples)
+
+        self.assertEqual(frames, starts)
+        self.assertEqual(locks, [(starts[0], True)])
+        # tracked frames sit exactly where they are expected
+        self.assertEqual(timing[1:], [0] * 5)
+        self.assertTrue(sync.locked())
+        self.assertEqual(sync.frames_detected(), 6)
+        self.assertEqual(sync.frames_missed(), 0)
+        self.assertEqual(sync.locks_acquired(), 1)
+        self.assertEqual(sync.locks_lost(), 0)
+
+    def test_002_unlock_relock(self):
+        sent = [True] * 4 + [False] * 4 + [True] * 4
+        samples, starts = frame_stream(self.preamble, self.cp_len, self.fft_len, sent)
+        sync = self.make_sync()
+        self.assertEqual(sync.max_missed_frames(), 2)
+        frames, locks, timing = self.run_sync(sync, samples)
+
+        # the third missing frame drops the lock, the tag goes to the start of
+        # the call that looked for it, half a frame ahead of its slot.
+        # Search then picks up the first frame after the gap.
+        self.assertEqual(frames, starts[0:4] + starts[8:12])
+        self.assertEqual(locks, [(starts[0], True),
+                                 (starts[6] - self.block_len // 2, False),
+                                 (starts[8], True)])
+        self.assertEqual(sync.frames_detected(), 8)
+        self.assertEqual(sync.frames_missed(), 3)
+        self.assertEqual(sync.locks_acquired(), 2)
+        self.assertEqual(sync.locks_lost(), 1)
+
+    def test_003_max_missed_frames(self):
+        sent = [True] * 4 + [False] + [True] * 4
+        samples, starts = frame_stream(self.preamble, self.cp_len, self.fft_len, sent)
+
+        # a single dropped frame is bridged by default
+        sync = self.make_sync()
+        frames, locks, timing = self.run_sync(sync, samples)
+        self.assertEqual(frames, starts[0:4] + starts[5:9])
+        self.assertEqual(locks, [(starts[0], True)])
+        self.assertEqual(sync.frames_missed(), 1)
+
+        # without tolerance it falls back to search and locks on the next frame
+        self.tb = gr.top_block()
+        sync = self.make_sync()
+        sync.set_max_missed_frames(0)
+        frames, locks, timing = self.run_sync(sync, samples)
+        self.assertEqual(frames, starts[0:4] + starts[5:9])
+        self.assertEqual(locks, [(starts[0], True),
+                                 (starts[4] - self.block_len // 2, False),
+                                 (starts[5], True)])
+        self.assertEqual(sync.locks_acquired(), 2)
+        self.assertEqual(sync.locks_lost(), 1)
+
+    def test_004_track_window(self):
+        delay = 5
+        delays = [0] * 3 + [delay] + [0] * 4
+        samples, starts = frame_stream(self.preamble, self.cp_len, self.fft_len, [True] * 8, delays)
+
+        # a timing jump within the track window is followed
+        sync = self.make_sync(track_window=8)
+        frames, locks, timing = self.run_sync(sync, samples)
+        self.assertEqual(frames, starts)
+        self.assertEqual(timing[1:], [0, 0, delay, 0, 0, 0, 0])
+        self.assertEqual(locks, [(starts[0], True)])
+
+        # beyond the window every frame is missed until search takes over
+        self.tb = gr.top_block()
+        sync = self.make_sync(track_window=3)
+        self.assertEqual(sync.track_window(), 3)
+        frames, locks, timing = self.run_sync(sync, samples)
+        self.assertEqual(frames, starts[0:3] + starts[6:8])
+        self.assertEqual(locks, [(starts[0], True),
+                                 (starts[5] - delay - self.block_len // 2, False),
+                                 (starts[6], True)])
+        self.assertEqual(sync.frames_missed(), 3)
+
+    def test_005_tracking_cost(self):
+        # Per frame, tracking must evaluate at least an order of magnitude fewer
+        # correlation lags than the search pipeline. Without stream outputs only the detector runs.
+        n_frames = 200
+        samples, starts = frame_stream(self.preamble, self.cp_len, self.fft_len, [True] * n_frames)
+
+        def run_detector(lock_threshold):
+            tb = gr.top_block()
+            sync = self.make_sync(lock_threshold)
+            tb.connect(blocks.vector_source_c(samples), sync)
+            tb.run()
+            return sync
+
+        # a metric above 1 is never reached, every frame goes through search
+        sync = run_detector(1.1)
+        self.assertEqual(sync.frames_detected(), 0)
+        # every item is autocorrelated, every frame yields a cross-correlation window
+        self.assertTrue(sync.autocorr_lags() >= (n_frames - 1) * self.block_len)
+        self.assertTrue(sync.xcorr_lags() >= (n_frames - 1))
+        search_lags = sync.autocorr_lags() + sync.xcorr_lags()
+
+        sync = run_detector(.6)
+        self.assertEqual(sync.frames_detected(), n_frames)
+        track_lags = sync.autocorr_lags() + sync.xcorr_lags()
+        self.assertGreater(search_lags, 10 * track_lags)
+
+    def test_006_energy_gate_noise(self):
+        n_blocks = 20
+        samples, starts = frame_stream(self.preamble, self.cp_len, self.fft_len, [False] * n_blocks)
+
+        # without the gate every block runs the correlation pipeline
+        sync = self.make_sync()
+        frames, locks, timing = self.run_sync(sync, samples)
+        self.assertEqual(frames, [])
+        self.assertEqual(sync.idle_blocks(), 0)
+
+        # the first block seeds the noise floor, every later one is skipped
+        self.tb = gr.top_block()
+        sync = self.make_sync(energy_threshold_db=6.)
+        src = blocks.vector_source_c(samples)
+        dst = blocks.vector_sink_c()
+        self.tb.connect(src, sync, dst)
+        self.tb.run()
+        n_searched = len(dst.data()) // self.block_len
+        self.assertTrue(n_searched >= n_blocks - 2)
+        self.assertEqual(sync.idle_blocks(), n_searched - 1)
+        self.assertEqual(sync.frames_detected(), 0)
+        self.assertEqual(len(dst.tags()), 0)
+        # 1e-3 per component
+        self.assertAlmostEqual(sync.noise_floor() / 2e-6, 1., 1)
+
+    def test_007_frame_after_idle(self):
+        n_idle = 20
+        sent = [False] * n_idle + [True] * 4
+        samples, starts = frame_stream(self.preamble, self.cp_len, self.fft_len, sent)
+        sync = self.make_sync(energy_threshold_db=6.)
+        frames, locks, timing = self.run_sync(sync, samples)
+
+        # the idle stretch is skipped, the first frame after it locks search
+        self.assertEqual(frames, starts[n_idle:])
+        self.assertEqual(locks, [(starts[n_idle], True)])
+        self.assertTrue(sync.idle_blocks() >= n_idle - 2)
+        self.assertEqual(sync.frames_detected(), 4)
+        self.assertEqual(sync.frames_missed(), 0)
+        # frame energy never leaks into the noise floor
+        self.assertAlmostEqual(sync.noise_floor() / 2e-6, 1., 1)
 
 
 if __name__ == '__main__':
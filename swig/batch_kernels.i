@@ -0,0 +1,97 @@
+/*
+ * numpy front end of batch_modulator and batch_receiver. Arrays are passed
+ * by address, so nothing is copied, and the GIL is released while the
+ * kernels run.
+ */
+
+%ignore gr::gfdm::batch_modulator::modulate;
+%ignore gr::gfdm::batch_receiver::demodulate;
+%ignore gr::gfdm::batch_receiver::demodulate_ic;
+
+%include "gfdm/batch_kernels.h"
+
+%{
+// run code without the GIL, exceptions go on to the %exception handler.
+#define GFDM_WITHOUT_GIL(code)                  \
+  {                                             \
+    PyThreadState* _gil_state = PyEval_SaveThread(); \
+    try{ code }                                 \
+    catch(...){                                 \
+      PyEval_RestoreThread(_gil_state);         \
+      throw;                                    \
+    }                                           \
+    PyEval_RestoreThread(_gil_state);           \
+  }
+%}
+
+%extend gr::gfdm::batch_modulator {
+  void _modulate(size_t out, size_t in, int n_frames)
+  {
+    GFDM_WITHOUT_GIL(
+      $self->modulate(reinterpret_cast<gr_complex*>(out), reinterpret_cast<const gr_complex*>(in), n_frames);
+    )
+  }
+
+  %pythoncode %{
+  def modulate(self, symbols, out=None):
+      """Modulate symbols of shape (n_frames, block_size()), complex64.
+
+      Writes to out (same shape) or a new array and returns it. Pass
+      out=symbols to modulate in place.
+      """
+      return _batch_run(self._modulate, symbols, self.block_size(), out, self.block_size())
+  %}
+}
+
+%extend gr::gfdm::batch_receiver {
+  void _demodulate_ic(size_t out, size_t in, int n_frames, int ic_iter, const std::vector<gr_complex>& constellation_points)
+  {
+    GFDM_WITHOUT_GIL(
+      $self->demodulate_ic(reinterpret_cast<gr_complex*>(out), reinterpret_cast<const gr_complex*>(in),
+                           n_frames, ic_iter, constellation_points);
+    )
+  }
+
+  %pythoncode %{
+  def demodulate(self, samples, out=None):
+      """Demodulate samples of shape (n_frames, fft_len()), complex64.
+
+      Returns symbols of shape (n_frames, block_size()), in place only if
+      fft_len() == block_size().
+      """
+      return self.demodulate_ic(samples, 0, [], out)
+
+  def demodulate_ic(self, samples, ic_iter, constellation_points, out=None):
+      """demodulate() with ic_iter SIC iterations against the nearest constellation point."""
+      points = [complex(p) for p in constellation_points]
+      run = lambda o, i, n: self._demodulate_ic(o, i, n, ic_iter, points)
+      return _batch_run(run, samples, self.fft_len(), out, self.block_size())
+  %}
+}
+
+%pythoncode %{
+def _batch_frames(a, frame_len, name):
+    import numpy
+    a = numpy.asarray(a)
+    if a.dtype != numpy.complex64:
+        raise TypeError("%s must be complex64, not %s" % (name, a.dtype))
+    if not a.flags.c_contiguous:
+        raise ValueError("%s must be C-contiguous" % name)
+    if a.ndim != 2 or a.shape[1] != frame_len:
+        raise ValueError("%s must have shape (n_frames, %d), not %s" % (name, frame_len, a.shape))
+    return a
+
+
+def _batch_run(run, data, in_len, out, out_len):
+    import numpy
+    data = _batch_frames(data, in_len, "input")
+    if out is None:
+        out = numpy.empty((data.shape[0], out_len), dtype=numpy.complex64)
+    out = _batch_frames(out, out_len, "out")
+    if not out.flags.writeable:
+        raise ValueError("out must be writeable")
+    if out.shape[0] != data.shape[0]:
+        raise ValueError("out must hold %d frames, not %d" % (data.shape[0], out.shape[0]))
+    run(out.ctypes.data, data.ctypes.data, data.shape[0])
+    return out
+%}
@@ -1,6 +1,7 @@
 /* -*- c++ -*- */
 
 #define GFDM_API
+#define GFDM_KERNELS_API
 #define DIGITAL_API
 
 %include "gnuradio.i"			// the common stuff
@@ -22,6 +23,10 @@
 #include "gfdm/simple_modulator_cc.h"
 #include "gfdm/modulator_kernel_cc.h"
 #include "gfdm/add_cyclic_prefix_cc.h"
+#include "gfdm/frame_receiver_cc.h"
+#include "gfdm/frame_transmitter_cc.h"
+#include "gfdm/tracer.h"
+#include "gfdm/batch_kernels.h"
 %}
 
 %include "gfdm/transmitter_cvc.h"
@@ -48,4 +53,10 @@ GR_SWIG_BLOCK_MAGIC2(gfdm, cyclic_prefixer_cc);
 GR_SWIG_BLOCK_MAGIC2(gfdm, remove_prefix_cc);
 %include "gfdm/simple_modulator_cc.h"
 GR_SWIG_BLOCK_MAGIC2(gfdm, simple_modulator_cc);
+%include "gfdm/frame_receiver_cc.h"
+GR_SWIG_BLOCK_MAGIC2(gfdm, frame_receiver_cc);
+%include "gfdm/frame_transmitter_cc.h"
+GR_SWIG_BLOCK_MAGIC2(gfdm, frame_transmitter_cc);
+%include "gfdm/tracer.h"
+%include "batch_kernels.i"
 //%include "gfdm/modulator_kernel_cc.h"